@@ -0,0 +1,201 @@
+// Hungarian algorithm (same potentials/way formulation as HungarianAlgorithm.cpp)
+// for many independent assignment problems.
+//
+//  - Costs are 64-bit and live in a heap allocated CostMatrix whose rows start on
+//    a 64 byte boundary and are padded to a multiple of 8 entries, so 500x500 and
+//    much larger instances never touch the stack.
+//  - The inner "for j" loop is split into a branchless reduced-cost/min scan
+//    (AVX2 when compiled with -mavx2, a plain loop the compiler can vectorise
+//    otherwise) and a separate argmin pass. `used` is kept as an all-ones mask
+//    per column so it can be blended instead of branched on.
+//  - solveBatch hands out instances to worker threads through a shared counter,
+//    each worker reuses one workspace for all the instances it solves.
+//
+// Input is the same as HungarianAlgorithm.cpp: t, then per test "m n" and the
+// cost matrix read column by column. Prints the minimum cost per test.
+// Compile with -O3 -mavx2 -pthread.
+#include <bits/stdc++.h>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+using namespace std;
+
+typedef long long ll;
+const ll INF = LLONG_MAX / 4;
+
+class CostMatrix
+{
+    public:
+        int rows, cols, stride;
+
+        CostMatrix(int rows, int cols) : rows(rows), cols(cols), stride(((cols + 1) + 7) & ~7),
+                                          data((ll*)aligned_alloc(64, sizeof(ll) * (size_t)(rows + 1) * stride))
+        {
+            if(!data)
+                throw bad_alloc();
+            memset(data.get(), 0, sizeof(ll) * (size_t)(rows + 1) * stride);
+        }
+
+        // 1-based like the original a[n+1][m+1]; row 0 and column 0 are padding
+        ll* row(int i) { return data.get() + (size_t)i * stride; }
+        const ll* row(int i) const { return data.get() + (size_t)i * stride; }
+        ll& at(int i, int j) { return row(i)[j]; }
+
+    private:
+        struct FreeDeleter { void operator()(ll* p) const { free(p); } };
+        unique_ptr<ll, FreeDeleter> data;
+};
+
+struct HungarianWorkspace
+{
+    vector<ll> u, v, minv, way, used; // used[j] is 0 or -1 (all bits set)
+    vector<int> p, usedList;
+
+    void reset(int n, int m)
+    {
+        u.assign(n+1, 0);
+        v.assign(m+1, 0);
+        p.assign(m+1, 0);
+        way.assign(m+1, 0);
+        minv.assign(m+1, INF);
+        used.assign(m+1, 0);
+    }
+};
+
+// Updates minv/way for the unused columns of row i0 and returns min minv over them
+static ll scanRow(const ll* a, ll ui0, int j0, int m, HungarianWorkspace& w)
+{
+    ll* v = w.v.data();
+    ll* minv = w.minv.data();
+    ll* way = w.way.data();
+    const ll* used = w.used.data();
+    ll delta = INF;
+    int j = 1;
+#ifdef __AVX2__
+    __m256i inf = _mm256_set1_epi64x(INF), uv = _mm256_set1_epi64x(ui0), j0v = _mm256_set1_epi64x(j0);
+    __m256i best = inf;
+    for(; j + 3 <= m; j += 4)
+    {
+        __m256i cur = _mm256_sub_epi64(_mm256_sub_epi64(_mm256_loadu_si256((const __m256i*)(a + j)), uv),
+                                       _mm256_loadu_si256((const __m256i*)(v + j)));
+        __m256i usedm = _mm256_loadu_si256((const __m256i*)(used + j));
+        cur = _mm256_blendv_epi8(cur, inf, usedm);
+        __m256i mv = _mm256_loadu_si256((const __m256i*)(minv + j));
+        __m256i lt = _mm256_cmpgt_epi64(mv, cur);
+        mv = _mm256_blendv_epi8(mv, cur, lt);
+        _mm256_storeu_si256((__m256i*)(minv + j), mv);
+        __m256i wy = _mm256_blendv_epi8(_mm256_loadu_si256((const __m256i*)(way + j)), j0v, lt);
+        _mm256_storeu_si256((__m256i*)(way + j), wy);
+        __m256i eff = _mm256_blendv_epi8(mv, inf, usedm);
+        best = _mm256_blendv_epi8(best, eff, _mm256_cmpgt_epi64(best, eff));
+    }
+    alignas(32) ll lanes[4];
+    _mm256_store_si256((__m256i*)lanes, best);
+    delta = min(min(lanes[0], lanes[1]), min(lanes[2], lanes[3]));
+#endif
+    for(; j <= m; j++)
+    {
+        ll cur = used[j] ? INF : a[j] - ui0 - v[j];
+        bool lt = cur < minv[j];
+        minv[j] = lt ? cur : minv[j];
+        way[j] = lt ? j0 : way[j];
+        ll eff = used[j] ? INF : minv[j];
+        delta = min(delta, eff);
+    }
+    return delta;
+}
+
+// Minimum cost assignment of every row to a distinct column, requires rows <= cols
+ll hungarian(const CostMatrix& a, HungarianWorkspace& w)
+{
+    int n = a.rows, m = a.cols;
+    w.reset(n, m);
+    for(int i = 1; i <= n; i++)
+    {
+        w.p[0] = i;
+        int j0 = 0;
+        fill(w.minv.begin(), w.minv.begin() + m + 1, INF);
+        fill(w.used.begin(), w.used.begin() + m + 1, 0);
+        w.usedList.clear();
+        do
+        {
+            w.used[j0] = -1;
+            w.usedList.push_back(j0);
+            int i0 = w.p[j0];
+            ll delta = scanRow(a.row(i0), w.u[i0], j0, m, w);
+            int j1 = 1;
+            while(w.used[j1] || w.minv[j1] != delta)
+                j1++;
+
+            for(int j : w.usedList)
+                w.u[w.p[j]] += delta;
+            ll* v = w.v.data();
+            ll* minv = w.minv.data();
+            const ll* used = w.used.data();
+            for(int j = 0; j <= m; j++)
+            {
+                v[j] -= delta & used[j];
+                minv[j] -= delta & ~used[j];
+            }
+            j0 = j1;
+        } while(w.p[j0] != 0);
+        do
+        {
+            int j1 = (int)w.way[j0];
+            w.p[j0] = w.p[j1];
+            j0 = j1;
+        } while(j0);
+    }
+    return -w.v[0];
+}
+
+vector<ll> solveBatch(const vector<CostMatrix>& instances, int threads)
+{
+    vector<ll> cost(instances.size());
+    atomic<size_t> next(0);
+    auto worker = [&]() {
+        HungarianWorkspace w;
+        for(size_t k; (k = next.fetch_add(1)) < instances.size(); )
+            cost[k] = hungarian(instances[k], w);
+    };
+    vector<thread> pool;
+    for(int t = 1; t < threads; t++)
+        pool.emplace_back(worker);
+    worker();
+    for(auto& th : pool)
+        th.join();
+    return cost;
+}
+
+int main()
+{
+    cin.sync_with_stdio(0); cin.tie(0);
+    int t;
+    if(!(cin >> t))
+        return 0;
+    vector<CostMatrix> instances;
+    instances.reserve(t);
+    for(int tc = 0; tc < t; tc++)
+    {
+        int n, m;
+        cin >> m >> n;
+        // The solver needs rows <= cols, transpose otherwise (the optimum is the same)
+        bool transpose = n > m;
+        instances.emplace_back(transpose ? m : n, transpose ? n : m);
+        CostMatrix& a = instances.back();
+        for(int j = 1; j <= m; j++)
+            for(int i = 1; i <= n; i++)
+            {
+                ll x;
+                cin >> x;
+                if(transpose)
+                    a.at(j, i) = x;
+                else
+                    a.at(i, j) = x;
+            }
+    }
+    vector<ll> cost = solveBatch(instances, max(1u, thread::hardware_concurrency()));
+    for(ll c : cost)
+        cout << c << "\n";
+    return 0;
+}
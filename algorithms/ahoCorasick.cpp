@@ -0,0 +1,297 @@
+// Multi-pattern matching with a flattened Aho-Corasick automaton.
+//
+// prefix_function_optimised (prefixFunctionTrivial.cpp) and KMPSearch
+// (patternMatchingString_wellsFargo.cpp) look for one pattern per pass over the
+// text; with thousands of signatures that is thousands of passes. Aho-Corasick
+// puts all patterns in one trie, and the failure link of a state is the
+// prefix function generalised to the trie: the longest proper suffix of the
+// state's string that is also a trie path. Resolving every failure chain at
+// build time turns the automaton into a DFA, so scanning is one table load per
+// input byte no matter how many patterns there are.
+//
+// Layout, chosen for the scan loop:
+//  - bytes are mapped to classes, one per byte value used by some pattern, plus
+//    class 0 for every other byte (which always leads back to the root)
+//  - states are numbered in BFS order, so the shallow states that the scan
+//    visits most are packed together
+//  - the table is one int array of rows [class 0 .. A-1 | output]; transitions
+//    store the row offset of the next state (state * width), so the loop does
+//    no multiplication, and the output column of the same row is the head of
+//    the state's match list (-1 if none), usually in the same cache line
+//  - match lists are linked through the failure links and share their tails
+//
+// Matcher::Stream keeps the state between feed() calls, so input can arrive in
+// chunks of any size and matches that cross chunk boundaries are still found.
+// save/load write the compiled automaton in a flat binary form.
+//
+// Usage: ./ahoCorasick [P] [MB]  P random signatures over a text of MB megabytes,
+// compared with one KMP pass per pattern.
+#include <bits/stdc++.h>
+using namespace std;
+
+class AhoCorasick
+{
+    public:
+        // Reports (pattern index, end offset): the match is [end - length, end)
+        class Stream
+        {
+            public:
+                Stream(const AhoCorasick& ac) : ac(ac) {}
+
+                template<class F>
+                void feed(const char* data, size_t len, F onMatch)
+                {
+                    const int32_t* t = ac.table.data();
+                    const uint16_t* cls = ac.cls.data();
+                    const int out = ac.width - 1;
+                    int32_t s = state;
+                    for(size_t i = 0; i < len; i++)
+                    {
+                        s = t[s + cls[(uint8_t)data[i]]];
+                        if(t[s + out] >= 0)
+                            for(int32_t e = t[s + out]; e >= 0; e = ac.outNext[e])
+                                onMatch(ac.outPattern[e], pos + i + 1);
+                    }
+                    state = s;
+                    pos += len;
+                }
+
+                void reset() { state = 0; pos = 0; }
+
+            private:
+                const AhoCorasick& ac;
+                int32_t state = 0;
+                uint64_t pos = 0;
+        };
+
+        AhoCorasick(const vector<string>& patterns)
+        {
+            // Byte classes
+            cls.fill(0);
+            int classes = 1;
+            for(const string& p : patterns)
+                for(unsigned char c : p)
+                    if(!cls[c])
+                        cls[c] = (uint16_t)classes++;
+            width = classes + 1;
+
+            // Trie, states in insertion order, -1 = no edge
+            vector<vector<int>> go(1, vector<int>(classes, -1));
+            vector<vector<int>> ends(1);
+            for(int id = 0; id < (int)patterns.size(); id++)
+            {
+                int s = 0;
+                for(unsigned char c : patterns[id])
+                {
+                    int& next = go[s][cls[c]];
+                    if(next < 0)
+                    {
+                        next = (int)go.size();
+                        go.push_back(vector<int>(classes, -1));
+                        ends.push_back({});
+                    }
+                    s = go[s][cls[c]];
+                }
+                ends[s].push_back(id);
+            }
+
+            // BFS from the root: new ids in BFS order, failure links, full transitions
+            int n = (int)go.size();
+            vector<int> order, fail(n, 0), newId(n);
+            order.reserve(n);
+            order.push_back(0);
+            for(size_t h = 0; h < order.size(); h++)
+            {
+                int s = order[h];
+                newId[s] = (int)h;
+                for(int c = 1; c < classes; c++)
+                {
+                    int next = go[s][c];
+                    if(next >= 0 && next != 0)
+                    {
+                        fail[next] = s == 0 ? 0 : go[fail[s]][c];
+                        order.push_back(next);
+                    }
+                    else
+                        go[s][c] = s == 0 ? 0 : go[fail[s]][c];
+                }
+                go[s][0] = 0;
+            }
+
+            table.assign((size_t)n * width, -1);
+            for(int h = 0; h < n; h++)
+            {
+                int s = order[h];
+                int32_t* row = table.data() + (size_t)h * width;
+                for(int c = 0; c < classes; c++)
+                    row[c] = newId[go[s][c]] * width;
+                // Own matches first, then the list of the failure state (already built)
+                int32_t head = s == 0 ? -1 : table[(size_t)newId[fail[s]] * width + width - 1];
+                for(int k = (int)ends[s].size() - 1; k >= 0; k--)
+                {
+                    outPattern.push_back(ends[s][k]);
+                    outNext.push_back(head);
+                    head = (int32_t)outPattern.size() - 1;
+                }
+                row[width - 1] = head;
+            }
+        }
+
+        size_t states() const { return table.size() / width; }
+        size_t bytes() const { return table.size() * 4 + outPattern.size() * 8; }
+
+        void save(ostream& os) const
+        {
+            uint32_t header[4] = {MAGIC, (uint32_t)width, (uint32_t)table.size(), (uint32_t)outPattern.size()};
+            os.write((const char*)header, sizeof(header));
+            os.write((const char*)cls.data(), cls.size() * 2);
+            os.write((const char*)table.data(), table.size() * 4);
+            os.write((const char*)outPattern.data(), outPattern.size() * 4);
+            os.write((const char*)outNext.data(), outNext.size() * 4);
+        }
+
+        static AhoCorasick load(istream& is)
+        {
+            AhoCorasick ac;
+            uint32_t header[4];
+            if(!is.read((char*)header, sizeof(header)) || header[0] != MAGIC)
+                throw runtime_error("not a serialized automaton");
+            // At most 256 byte classes plus class 0, and a root row
+            if(header[1] < 2 || header[1] > 258 || header[2] == 0 || header[2] % header[1] != 0
+               || header[2] > (uint32_t)INT32_MAX)
+                throw runtime_error("bad automaton dimensions");
+            ac.width = (int)header[1];
+            ac.table.resize(header[2]);
+            ac.outPattern.resize(header[3]);
+            ac.outNext.resize(header[3]);
+            is.read((char*)ac.cls.data(), ac.cls.size() * 2);
+            is.read((char*)ac.table.data(), ac.table.size() * 4);
+            is.read((char*)ac.outPattern.data(), ac.outPattern.size() * 4);
+            if(!is.read((char*)ac.outNext.data(), ac.outNext.size() * 4))
+                throw runtime_error("truncated automaton");
+
+            // feed() indexes the table without checks, so everything it can
+            // reach has to stay inside it
+            const int64_t cells = (int64_t)ac.table.size(), outputs = (int64_t)ac.outPattern.size();
+            for(uint16_t c : ac.cls)
+                if(c >= ac.width - 1)
+                    throw runtime_error("byte class out of range");
+            for(int64_t i = 0; i < cells; i++)
+            {
+                int32_t v = ac.table[i];
+                if(i % ac.width == ac.width - 1 ? v < -1 || v >= outputs : v < 0 || v >= cells || v % ac.width)
+                    throw runtime_error("corrupt automaton table");
+            }
+            // A list entry only points to an older one, so every list ends
+            for(int64_t e = 0; e < outputs; e++)
+                if(ac.outPattern[e] < 0 || ac.outNext[e] < -1 || ac.outNext[e] >= e)
+                    throw runtime_error("corrupt match list");
+            return ac;
+        }
+
+    private:
+        static const uint32_t MAGIC = 0x41434632; // "ACF2"
+        int width = 0;
+        array<uint16_t, 256> cls;
+        vector<int32_t> table;
+        vector<int32_t> outPattern, outNext;
+
+        AhoCorasick() {}
+};
+
+// Occurrences of pat in txt (overlapping), prefix_function_optimised over pat + '\0' + txt
+// without building the concatenation
+long long kmpCount(const string& pat, const string& txt)
+{
+    int m = (int)pat.size();
+    vector<int> pi(m, 0);
+    for(int i = 1; i < m; i++)
+    {
+        int j = pi[i-1];
+        while(j > 0 && pat[i] != pat[j])
+            j = pi[j-1];
+        if(pat[i] == pat[j])
+            j++;
+        pi[i] = j;
+    }
+    long long res = 0;
+    int j = 0;
+    for(char c : txt)
+    {
+        while(j > 0 && c != pat[j])
+            j = pi[j-1];
+        if(c == pat[j])
+            j++;
+        if(j == m)
+        {
+            res++;
+            j = pi[j-1];
+        }
+    }
+    return res;
+}
+
+int main(int argc, char** argv)
+{
+    // The example from patternMatchingString_wellsFargo.cpp plus two more patterns
+    string txt = "eekseeksgeeekseksforgeekseeeeeeekseeksekeeeeksks";
+    vector<string> pats = {"eeks", "geek", "ks"};
+    AhoCorasick small(pats);
+    vector<int> count(pats.size(), 0);
+    AhoCorasick::Stream st(small);
+    st.feed(txt.data(), txt.size(), [&](int id, uint64_t) { count[id]++; });
+    for(size_t i = 0; i < pats.size(); i++)
+        printf("%s: %d\n", pats[i].c_str(), count[i]);
+
+    // Random signatures over a small alphabet so that they actually occur
+    int p = argc > 1 ? atoi(argv[1]) : 2000;
+    int mb = argc > 2 ? atoi(argv[2]) : 16;
+    mt19937 rng(3);
+    vector<string> sigs(p);
+    for(auto& s : sigs)
+    {
+        s.resize(4 + rng() % 9);
+        for(auto& c : s)
+            c = 'a' + rng() % 8;
+    }
+    string text((size_t)mb << 20, ' ');
+    for(auto& c : text)
+        c = 'a' + rng() % 10;
+
+    auto timeIt = [](auto f) {
+        auto start = chrono::steady_clock::now();
+        f();
+        return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    };
+
+    AhoCorasick* ac = nullptr;
+    double tBuild = timeIt([&]() { ac = new AhoCorasick(sigs); });
+
+    // Round trip through the binary form, then scan in 64 KB chunks
+    stringstream blob;
+    ac->save(blob);
+    AhoCorasick loaded = AhoCorasick::load(blob);
+    vector<long long> hits(p, 0);
+    double tScan = timeIt([&]() {
+        AhoCorasick::Stream s(loaded);
+        for(size_t off = 0; off < text.size(); off += 1 << 16)
+            s.feed(text.data() + off, min<size_t>(1 << 16, text.size() - off),
+                   [&](int id, uint64_t) { hits[id]++; });
+    });
+
+    // KMP per pattern, timed on a sample and extrapolated
+    int sample = min(p, 20);
+    bool ok = true;
+    double tKmp = timeIt([&]() {
+        for(int i = 0; i < sample; i++)
+            ok &= kmpCount(sigs[i], text) == hits[i];
+    }) * p / sample;
+
+    printf("\n%d patterns, %zu states (%.1f MB), %d MB of text\n", p, ac->states(), ac->bytes() / 1e6, mb);
+    printf("build %.3f s, serialized %zu bytes\n", tBuild, blob.str().size());
+    printf("Aho-Corasick single pass  %.3f s\n", tScan);
+    printf("KMP per pattern           %.3f s (estimated from %d patterns, %.0fx)\n", tKmp, sample, tKmp / tScan);
+    printf(ok ? "results match\n" : "MISMATCH\n");
+    delete ac;
+    return 0;
+}
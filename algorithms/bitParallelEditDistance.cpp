@@ -0,0 +1,227 @@
+// Bit-parallel (Myers / Hyyro) Levenshtein distance.
+//
+// Solution::minDistance in interviewbit/editDistance.cpp fills an int[m+1][n+1]
+// VLA on the stack: O(mn) time and memory, and a stack overflow for long inputs.
+// Myers' algorithm keeps one DP column as two bit vectors, Pv / Mv = "the value
+// increases / decreases by one going down at this row", so a column of 64 rows
+// is updated with about 15 word operations. Longer patterns are split into
+// 64-row blocks that pass the horizontal delta of their bottom row (+1/0/-1) on
+// to the block below (Hyyro's blocked formulation).
+//
+// Distance cutoff k (banded mode): D[i][j] >= |i - j| and the rest of the path
+// costs at least |(m - i) - (n - j)|, so in column j only rows in
+//    [max(j - k, j + m - n - k), min(j + k, j + m - n + k)]
+// can be on a path of cost <= k (Ukkonen). Blocks above the band are dropped and
+// blocks below it are started only when the band reaches them, so a column costs
+// O(k / 64) words instead of O(m / 64). Values outside the band are replaced by
+// upper bounds (+1 per step), so computed values never drop below the true ones
+// and every cell on a path of cost <= k is still exact. After each
+// column a lower bound on the final distance is checked, and the search gives up
+// (returns -1) as soon as it exceeds k.
+//
+// EditDistance preprocesses the pattern once (one bit mask per byte value and
+// block), so scoring a query against many candidates only pays for the scans.
+#include <bits/stdc++.h>
+using namespace std;
+
+class EditDistance
+{
+    public:
+        EditDistance(string_view pattern)
+            : m((int)pattern.size()), words(max(1, (m + 63) / 64)), peq((size_t)256 * words, 0)
+        {
+            for(int i = 0; i < m; i++)
+                peq[(size_t)(unsigned char)pattern[i] * words + i / 64] |= 1ULL << (i % 64);
+        }
+
+        // Levenshtein distance to text, or -1 if it is larger than maxDist
+        int distance(string_view text, int maxDist = INT_MAX) const
+        {
+            Workspace ws(words);
+            return run(text, maxDist, ws);
+        }
+
+        // Batch mode: the distance (or -1 if > maxDist) to every candidate
+        vector<int> distances(const vector<string>& candidates, int maxDist = INT_MAX) const
+        {
+            Workspace ws(words);
+            vector<int> res(candidates.size());
+            for(size_t i = 0; i < candidates.size(); i++)
+                res[i] = run(candidates[i], maxDist, ws);
+            return res;
+        }
+
+    private:
+        int m, words;
+        vector<uint64_t> peq; // peq[c * words + b]: rows of block b holding byte c
+
+        struct Workspace
+        {
+            vector<uint64_t> pv, mv;
+            vector<int> score; // D at the bottom row of each block
+            Workspace(int w) : pv(w), mv(w), score(w) {}
+        };
+
+        // Advances one block by one text column; returns the bottom row's horizontal delta
+        static int advance(uint64_t& pv, uint64_t& mv, uint64_t eq, int hin, uint64_t high)
+        {
+            uint64_t xv = eq | mv;
+            if(hin < 0)
+                eq |= 1;
+            uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+            uint64_t ph = mv | ~(xh | pv);
+            uint64_t mh = pv & xh;
+            int hout = (ph & high) ? 1 : (mh & high) ? -1 : 0;
+            ph <<= 1;
+            mh <<= 1;
+            if(hin < 0)
+                mh |= 1;
+            else if(hin > 0)
+                ph |= 1;
+            pv = mh | ~(xv | ph);
+            mv = ph & xv;
+            return hout;
+        }
+
+        int rowsIn(int b) const { return min(64, m - 64 * b); }
+        uint64_t highBit(int b) const { return 1ULL << (rowsIn(b) - 1); }
+
+        int run(string_view text, int maxDist, Workspace& ws) const
+        {
+            const int n = (int)text.size();
+            const long long k = min<long long>(maxDist, max(m, n));
+            if(abs(m - n) > k)
+                return -1;
+            if(m == 0 || n == 0)
+                return max(m, n);
+
+            int first = 0, last = -1;
+            for(int j = 1; j <= n; j++)
+            {
+                const uint64_t* eq = peq.data() + (size_t)(unsigned char)text[j-1] * words;
+                long long lo = max<long long>(j - k, j + m - n - k);
+                long long hi = min<long long>({j + k, j + m - n + k, (long long)m});
+                int newFirst = max(first, lo >= 1 ? (int)((lo - 1) / 64) : 0);
+                int newLast = (int)((hi - 1) / 64);
+
+                // Active blocks; above the first one the band assumes +1 (as row 0 does)
+                int hin = 1;
+                for(int b = newFirst; b <= last; b++)
+                {
+                    hin = advance(ws.pv[b], ws.mv[b], eq[b], hin, highBit(b));
+                    ws.score[b] += hin;
+                }
+                // Blocks entering the band start as "+1 per row" below the bottom of
+                // block b-1 in column j-1 (an upper bound, which is all the band needs)
+                for(int b = max(last + 1, newFirst); b <= newLast; b++)
+                {
+                    int above = 0, hinB = 1;
+                    if(b == 0)
+                        above = j - 1;
+                    else if(b - 1 >= newFirst)
+                        above = ws.score[b-1] - hin, hinB = hin;
+                    else
+                        above = ws.score[b-1]; // dropped in this column, still holds j-1
+                    ws.pv[b] = ~0ULL;
+                    ws.mv[b] = 0;
+                    ws.score[b] = above + rowsIn(b);
+                    hin = advance(ws.pv[b], ws.mv[b], eq[b], hinB, highBit(b));
+                    ws.score[b] += hin;
+                }
+                first = newFirst;
+                last = max(last, newLast);
+
+                if(k < max(m, n))
+                {
+                    // Lower bound: in block b, D[i][j] >= score - (bottom - i), plus the
+                    // distance |i - target| to the diagonal that ends in (m, n). Row 0
+                    // (D = j) is not in a block and is counted separately.
+                    long long target = j + m - n, best = j + llabs(target);
+                    for(int b = first; b <= last; b++)
+                    {
+                        long long top = 64LL * b + 1, bottom = 64LL * b + rowsIn(b);
+                        best = min(best, ws.score[b] - bottom + max(target, 2 * top - target));
+                    }
+                    if(best > k)
+                        return -1;
+                }
+            }
+            int d = ws.score[words - 1];
+            return last == words - 1 && d <= k ? d : -1;
+        }
+};
+
+// interviewbit/editDistance.cpp, with two rows instead of the VLA
+int minDistanceDP(const string& A, const string& B)
+{
+    int m = A.length(), n = B.length();
+    vector<int> prev(n + 1), cur(n + 1);
+    iota(prev.begin(), prev.end(), 0);
+    for(int i = 1; i <= m; i++)
+    {
+        cur[0] = i;
+        for(int j = 1; j <= n; j++)
+            cur[j] = min({prev[j] + 1, cur[j-1] + 1, prev[j-1] + (A[i-1] != B[j-1])});
+        swap(prev, cur);
+    }
+    return prev[n];
+}
+
+template<class F>
+double timeIt(F f)
+{
+    auto start = chrono::steady_clock::now();
+    f();
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main()
+{
+    printf("minDistance(\"Anshuman\", \"Antihuman\") = %d\n", EditDistance("Anshuman").distance("Antihuman"));
+
+    mt19937 rng(12);
+    auto randomString = [&](int len, int sigma) {
+        string s(len, ' ');
+        for(auto& c : s)
+            c = 'a' + rng() % sigma;
+        return s;
+    };
+
+    // Two long strings: full DP vs bit-parallel, and with a cutoff
+    string a = randomString(20000, 4), b = a;
+    for(int e = 0; e < 200; e++)
+        b[rng() % b.size()] = 'a' + rng() % 4;
+    int dDp = 0, dBit = 0, dBand = 0;
+    double tDp = timeIt([&]() { dDp = minDistanceDP(a, b); });
+    double tBit = timeIt([&]() { dBit = EditDistance(a).distance(b); });
+    double tBand = timeIt([&]() { dBand = EditDistance(a).distance(b, 300); });
+    printf("\n20000 x 20000: DP %.3f s, bit-parallel %.3f s, banded (k = 300) %.4f s\n", tDp, tBit, tBand);
+    printf("distances %d / %d / %d\n", dDp, dBit, dBand);
+
+    // Fuzzy lookup: one query against many candidates, within distance 2
+    string query = randomString(24, 8);
+    vector<string> candidates(200000);
+    for(auto& c : candidates)
+    {
+        c = rng() % 50 ? randomString(20 + rng() % 9, 8) : query;
+        if(rng() % 2)
+            c[rng() % c.size()] = 'a' + rng() % 8;
+    }
+    vector<int> batch, dp(candidates.size());
+    double tBatch = timeIt([&]() { batch = EditDistance(query).distances(candidates, 2); });
+    double tBatchDp = timeIt([&]() {
+        for(size_t i = 0; i < candidates.size(); i++)
+            dp[i] = minDistanceDP(query, candidates[i]);
+    });
+    int hits = 0;
+    bool ok = true;
+    for(size_t i = 0; i < candidates.size(); i++)
+    {
+        hits += batch[i] >= 0;
+        ok &= batch[i] == (dp[i] <= 2 ? dp[i] : -1);
+    }
+    printf("\n%zu candidates, k = 2: batch %.3f s, DP %.3f s, %d within distance 2\n",
+           candidates.size(), tBatch, tBatchDp, hits);
+    printf(ok && dDp == dBit && dBit == dBand ? "results match\n" : "MISMATCH\n");
+    return 0;
+}
@@ -0,0 +1,226 @@
+// Longest common subsequence in linear space.
+//
+// interviewbit/longestCommonSubsequence.cpp keeps the whole (n+1) x (m+1) table
+// as a VLA and ESO207/BPA3/longestCommonSubsequence.cpp two rows of it, both one
+// cell per step. Here:
+//
+//  - lcsLength: bit-parallel row (Allison-Dix, in Hyyro's form). Bit j of V is 0
+//    where the LCS row steps up at column j, so after reading a[0..i) the number
+//    of zeros among the first j bits is LCS(a[0..i), b[0..j)). One character of
+//    a updates V with
+//        U = V & match[c];   V = (V + U) | (V - U)
+//    i.e. 64 columns per word. V - U is just V & ~match[c], so only the
+//    addition needs a carry across words.
+//  - lcs: Hirschberg. The LCS row of the top half of a (read forward) and of the
+//    bottom half (both strings reversed) meet at a column j where the sum is
+//    maximal; the halves are solved recursively left and right of j. Each row
+//    comes from the bit-parallel scan plus prefix popcounts, so the whole thing
+//    is about twice the cost of lcsLength and O(n + m) memory.
+//
+// Usage: ./bitParallelLCS [N]  two related random strings of length N
+// (default 10^5; 10^6 works, the DP table for that would need 4 TB).
+#include <bits/stdc++.h>
+using namespace std;
+
+// Bit-parallel LCS rows of a (read in order) against b
+class LCSRow
+{
+    public:
+        // row[j] = LCS(a, b[0..j)) for j = 0..|b|
+        static vector<int> row(string_view a, string_view b)
+        {
+            vector<uint64_t> v = scan(a, b);
+            vector<int> res(b.size() + 1, 0);
+            int zeros = 0;
+            for(size_t j = 0; j < b.size(); j++)
+            {
+                zeros += !((v[j / 64] >> (j % 64)) & 1);
+                res[j + 1] = zeros;
+            }
+            return res;
+        }
+
+        static int length(string_view a, string_view b)
+        {
+            vector<uint64_t> v = scan(a, b);
+            long long ones = 0;
+            for(uint64_t w : v)
+                ones += __builtin_popcountll(w);
+            return (int)(b.size() - ones);
+        }
+
+    private:
+        static vector<uint64_t> scan(string_view a, string_view b)
+        {
+            size_t words = (b.size() + 63) / 64;
+            // Match masks only for the bytes that occur in a
+            array<int, 256> id;
+            id.fill(-1);
+            int sigma = 0;
+            for(unsigned char c : a)
+                if(id[c] < 0)
+                    id[c] = sigma++;
+            vector<uint64_t> match((size_t)sigma * words, 0);
+            for(size_t j = 0; j < b.size(); j++)
+                if(id[(unsigned char)b[j]] >= 0)
+                    match[id[(unsigned char)b[j]] * words + j / 64] |= 1ULL << (j % 64);
+
+            vector<uint64_t> v(words, ~0ULL);
+            if(b.size() % 64)
+                v[words - 1] = (1ULL << (b.size() % 64)) - 1;
+            for(unsigned char c : a)
+            {
+                const uint64_t* m = match.data() + id[c] * words;
+                uint64_t carry = 0;
+                for(size_t w = 0; w < words; w++)
+                {
+                    uint64_t x = v[w];
+                    unsigned long long sum;
+                    uint64_t c1 = __builtin_uaddll_overflow(x, x & m[w], &sum);
+                    uint64_t c2 = __builtin_uaddll_overflow(sum, carry, &sum);
+                    carry = c1 | c2;
+                    v[w] = sum | (x & ~m[w]);
+                }
+                if(b.size() % 64)
+                    v[words - 1] &= (1ULL << (b.size() % 64)) - 1;
+            }
+            return v;
+        }
+};
+
+int lcsLength(string_view a, string_view b)
+{
+    // Bits over the shorter string: same work, less memory
+    return a.size() < b.size() ? LCSRow::length(b, a) : LCSRow::length(a, b);
+}
+
+class Hirschberg
+{
+    public:
+        Hirschberg(string_view a, string_view b) : a(a), b(b), ra(a.rbegin(), a.rend()), rb(b.rbegin(), b.rend()) {}
+
+        string solve()
+        {
+            out.clear();
+            rec(0, a.size(), 0, b.size());
+            return out;
+        }
+
+    private:
+        string_view a, b;
+        string ra, rb, out;
+
+        void rec(size_t aL, size_t aR, size_t bL, size_t bR)
+        {
+            size_t n = aR - aL, m = bR - bL;
+            if(n == 0 || m == 0)
+                return;
+            if(n == 1 || n * m <= 4096)
+                return small(aL, aR, bL, bR);
+            size_t mid = aL + n / 2;
+            vector<int> top = LCSRow::row(a.substr(aL, mid - aL), b.substr(bL, m));
+            vector<int> bottom = LCSRow::row(string_view(ra).substr(a.size() - aR, aR - mid),
+                                             string_view(rb).substr(b.size() - bR, m));
+            size_t split = 0;
+            int best = -1;
+            for(size_t j = 0; j <= m; j++)
+                if(top[j] + bottom[m - j] > best)
+                {
+                    best = top[j] + bottom[m - j];
+                    split = j;
+                }
+            rec(aL, mid, bL, bL + split);
+            rec(mid, aR, bL + split, bR);
+        }
+
+        // Plain DP with traceback for small blocks
+        void small(size_t aL, size_t aR, size_t bL, size_t bR)
+        {
+            size_t n = aR - aL, m = bR - bL;
+            vector<int> dp((n + 1) * (m + 1), 0);
+            auto at = [&](size_t i, size_t j) -> int& { return dp[i * (m + 1) + j]; };
+            for(size_t i = 1; i <= n; i++)
+                for(size_t j = 1; j <= m; j++)
+                    at(i, j) = a[aL + i - 1] == b[bL + j - 1] ? at(i - 1, j - 1) + 1
+                                                              : max(at(i - 1, j), at(i, j - 1));
+            string piece;
+            for(size_t i = n, j = m; i && j; )
+            {
+                if(a[aL + i - 1] == b[bL + j - 1])
+                {
+                    piece += a[aL + i - 1];
+                    i--, j--;
+                }
+                else if(at(i - 1, j) >= at(i, j - 1))
+                    i--;
+                else
+                    j--;
+            }
+            out.append(piece.rbegin(), piece.rend());
+        }
+};
+
+string lcs(string_view a, string_view b)
+{
+    return Hirschberg(a, b).solve();
+}
+
+// computeLCS from ESO207/BPA3/longestCommonSubsequence.cpp (two rows)
+int lcsDP(const string& a, const string& b)
+{
+    vector<int> prev(b.size() + 1, 0), cur(b.size() + 1, 0);
+    for(size_t i = 1; i <= a.size(); i++)
+    {
+        for(size_t j = 1; j <= b.size(); j++)
+            cur[j] = a[i-1] == b[j-1] ? prev[j-1] + 1 : max(cur[j-1], prev[j]);
+        swap(prev, cur);
+    }
+    return prev[b.size()];
+}
+
+static bool isSubsequence(const string& s, const string& of)
+{
+    size_t k = 0;
+    for(char c : of)
+        if(k < s.size() && s[k] == c)
+            k++;
+    return k == s.size();
+}
+
+template<class F>
+double timeIt(F f)
+{
+    auto start = chrono::steady_clock::now();
+    f();
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv)
+{
+    cout << "lcs(AGGTAB, GXTXAYB) = " << lcs("AGGTAB", "GXTXAYB") << " (" << lcsLength("AGGTAB", "GXTXAYB") << ")" << endl;
+
+    int n = argc > 1 ? atoi(argv[1]) : 100000;
+    mt19937 rng(21);
+    string a(n, ' ');
+    for(auto& c : a)
+        c = "ACGT"[rng() % 4];
+    string b = a;
+    for(int e = 0; e < n / 5; e++)
+        b[rng() % n] = "ACGT"[rng() % 4];
+
+    int len = 0;
+    string sub;
+    double tLen = timeIt([&]() { len = lcsLength(a, b); });
+    double tLcs = timeIt([&]() { sub = lcs(a, b); });
+    cout << "\nN = " << n << ": bit-parallel length " << tLen << " s, Hirschberg " << tLcs << " s, LCS = " << len << endl;
+    bool ok = (int)sub.size() == len && isSubsequence(sub, a) && isSubsequence(sub, b);
+    // The quadratic DP only on a prefix, it needs about 4 ns per cell
+    string pa = a.substr(0, 20000), pb = b.substr(0, 20000);
+    int dp = 0, bits = 0;
+    double tDp = timeIt([&]() { dp = lcsDP(pa, pb); });
+    double tBits = timeIt([&]() { bits = lcsLength(pa, pb); });
+    cout << "prefixes of 20000: two-row DP " << tDp << " s, bit-parallel " << tBits << " s" << endl;
+    ok &= dp == bits;
+    cout << (ok ? "results match" : "MISMATCH") << endl;
+    return 0;
+}
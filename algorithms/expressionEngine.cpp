@@ -0,0 +1,493 @@
+// Compile an infix formula once, evaluate it over millions of rows.
+//
+// ESO207/PA2/infixToPostfix.cpp and geeksforgeeks/infixToPostfix.cpp handle
+// one-character operands and print the postfix string. Here the same
+// shunting-yard pass feeds a small compiler:
+//
+//  - Tokenizer: identifiers ([A-Za-z_][A-Za-z0-9_]*), numbers (123, 4.5, 1e-3),
+//    + - * / ^ and parentheses, with the offset of every token for errors.
+//  - Parser: shunting-yard (^ is right-associative and binds tighter than a
+//    unary minus, so -a^2 = -(a^2)). Instead of appending operators to a string
+//    it emits stack-machine bytecode; operations on two constants are folded.
+//  - Evaluator: the bytecode runs once per batch of 1024 rows instead of once per
+//    row. Every stack slot is a 1024-double register, each instruction is a
+//    plain loop over the batch that the compiler vectorises, and pushing a
+//    column only points the slot at the input, so nothing is copied. The
+//    interpreter's dispatch cost is paid once per 1024 rows.
+//
+// Errors (unknown character, missing operand, unbalanced parentheses, unknown
+// column) are reported as invalid_argument with the offset in the formula.
+#include <bits/stdc++.h>
+using namespace std;
+
+class Expression
+{
+    public:
+        static constexpr size_t Batch = 1024;
+
+        enum class Op : uint8_t { Column, Const, Add, Sub, Mul, Div, Pow, Neg, PowInt };
+        struct Instr
+        {
+            Op op;
+            uint32_t arg; // column, constant index or PowInt exponent
+        };
+
+        Expression(string_view formula)
+        {
+            compile(formula);
+        }
+
+        // Column names in order of first use; evaluate() takes the columns in this order
+        const vector<string>& variables() const { return names; }
+        const vector<Instr>& bytecode() const { return code; }
+
+        // The program read back as postfix, e.g. "a b c * +"
+        string postfix() const
+        {
+            string out;
+            for(const Instr& in : code)
+            {
+                if(!out.empty())
+                    out += ' ';
+                switch(in.op)
+                {
+                    case Op::Column: out += names[in.arg]; break;
+                    case Op::Const:
+                    {
+                        ostringstream os;
+                        os << consts[in.arg];
+                        out += os.str();
+                        break;
+                    }
+                    case Op::Neg: out += "neg"; break;
+                    case Op::PowInt: out += to_string(in.arg) + " ^"; break;
+                    default: out += "+-*/^"[(int)in.op - (int)Op::Add];
+                }
+            }
+            return out;
+        }
+
+        // out[r] = formula on row r, columns[i] holding variables()[i]
+        void evaluate(const vector<const double*>& columns, size_t rows, double* out) const
+        {
+            if(columns.size() != names.size())
+                throw invalid_argument("expected " + to_string(names.size()) + " columns");
+            // Two registers per stack slot: an instruction writes the one its left
+            // operand is not in, so no loop has overlapping input and output and all
+            // of them run exactly Batch iterations (the last, partial batch works on
+            // zero-padded copies of the columns)
+            vector<double> regs(2 * maxDepth * Batch);
+            vector<const double*> slot(maxDepth);
+            auto target = [&](size_t k) {
+                double* r = regs.data() + 2 * k * Batch;
+                return slot[k] == r ? r + Batch : r;
+            };
+            for(size_t base = 0; base < rows; base += Batch)
+            {
+                const size_t len = min(Batch, rows - base);
+                size_t depth = 0;
+                for(const Instr& in : code)
+                {
+                    switch(in.op)
+                    {
+                        case Op::Column:
+                            if(len == Batch)
+                                slot[depth] = columns[in.arg] + base;
+                            else
+                            {
+                                double* reg = target(depth);
+                                copy(columns[in.arg] + base, columns[in.arg] + base + len, reg);
+                                fill(reg + len, reg + Batch, 0.0);
+                                slot[depth] = reg;
+                            }
+                            depth++;
+                            break;
+                        case Op::Const:
+                        {
+                            double* reg = target(depth);
+                            fill(reg, reg + Batch, consts[in.arg]);
+                            slot[depth++] = reg;
+                            break;
+                        }
+                        case Op::Neg:
+                        case Op::PowInt:
+                        {
+                            double* reg = target(depth - 1);
+                            unary(in, slot[depth - 1], reg);
+                            slot[depth - 1] = reg;
+                            break;
+                        }
+                        default:
+                        {
+                            double* reg = target(depth - 2);
+                            binary(in.op, slot[depth - 2], slot[depth - 1], reg);
+                            slot[depth - 2] = reg;
+                            depth--;
+                        }
+                    }
+                }
+                copy(slot[0], slot[0] + len, out + base);
+            }
+        }
+
+        // Same, with the columns looked up by name
+        vector<double> evaluate(const unordered_map<string, vector<double>>& table) const
+        {
+            vector<const double*> columns;
+            size_t rows = SIZE_MAX;
+            for(const string& name : names)
+            {
+                auto it = table.find(name);
+                if(it == table.end())
+                    throw invalid_argument("unknown column '" + name + "'");
+                rows = min(rows, it->second.size());
+                columns.push_back(it->second.data());
+            }
+            if(rows == SIZE_MAX)
+                rows = 1; // constant formula
+            vector<double> out(rows);
+            evaluate(columns, rows, out.data());
+            return out;
+        }
+
+        // One row at a time through the same bytecode (what a per-row interpreter costs)
+        double evaluateRow(const vector<const double*>& columns, size_t row) const
+        {
+            double stack[64] = {};
+            vector<double> big;
+            double* st = stack;
+            if(maxDepth > 64)
+            {
+                big.resize(maxDepth);
+                st = big.data();
+            }
+            size_t depth = 0;
+            for(const Instr& in : code)
+                switch(in.op)
+                {
+                    case Op::Column: st[depth++] = columns[in.arg][row]; break;
+                    case Op::Const: st[depth++] = consts[in.arg]; break;
+                    case Op::Neg: st[depth - 1] = -st[depth - 1]; break;
+                    case Op::PowInt: st[depth - 1] = powi(st[depth - 1], in.arg); break;
+                    default:
+                        st[depth - 2] = apply(in.op, st[depth - 2], st[depth - 1]);
+                        depth--;
+                }
+            return st[0];
+        }
+
+    private:
+        enum class Tok { Number, Ident, Operator, LParen, RParen, End };
+        struct Token
+        {
+            Tok kind;
+            string_view text;
+            size_t pos;
+            double value;
+        };
+
+        vector<Instr> code;
+        vector<double> consts;
+        vector<string> names;
+        size_t maxDepth = 0;
+
+        [[noreturn]] static void fail(const string& what, size_t pos)
+        {
+            throw invalid_argument(what + " at offset " + to_string(pos));
+        }
+
+        static vector<Token> tokenize(string_view s)
+        {
+            vector<Token> toks;
+            size_t i = 0;
+            while(i < s.size())
+            {
+                unsigned char c = s[i];
+                size_t start = i;
+                if(isspace(c))
+                {
+                    i++;
+                    continue;
+                }
+                if(isalpha(c) || c == '_')
+                {
+                    while(i < s.size() && (isalnum((unsigned char)s[i]) || s[i] == '_'))
+                        i++;
+                    toks.push_back({Tok::Ident, s.substr(start, i - start), start, 0});
+                }
+                else if(isdigit(c) || (c == '.' && i + 1 < s.size() && isdigit((unsigned char)s[i + 1])))
+                {
+                    while(i < s.size() && (isdigit((unsigned char)s[i]) || s[i] == '.'))
+                        i++;
+                    if(i < s.size() && (s[i] == 'e' || s[i] == 'E'))
+                    {
+                        size_t j = i + 1;
+                        if(j < s.size() && (s[j] == '+' || s[j] == '-'))
+                            j++;
+                        if(j < s.size() && isdigit((unsigned char)s[j]))
+                        {
+                            i = j;
+                            while(i < s.size() && isdigit((unsigned char)s[i]))
+                                i++;
+                        }
+                    }
+                    string text(s.substr(start, i - start));
+                    size_t used = 0;
+                    double v = 0;
+                    try
+                    {
+                        v = stod(text, &used);
+                    }
+                    catch(const out_of_range&)
+                    {
+                        fail("number out of range '" + text + "'", start);
+                    }
+                    if(used != text.size())
+                        fail("bad number '" + text + "'", start);
+                    toks.push_back({Tok::Number, s.substr(start, i - start), start, v});
+                }
+                else if(c && strchr("+-*/^", c))
+                    toks.push_back({Tok::Operator, s.substr(i++, 1), start, 0});
+                else if(c == '(')
+                    toks.push_back({Tok::LParen, s.substr(i++, 1), start, 0});
+                else if(c == ')')
+                    toks.push_back({Tok::RParen, s.substr(i++, 1), start, 0});
+                else
+                    fail(string("unexpected '") + (char)c + "'", start);
+            }
+            toks.push_back({Tok::End, {}, s.size(), 0});
+            return toks;
+        }
+
+        // prec from geeksforgeeks/infixToPostfix.cpp, with unary minus between * and ^
+        static int prec(Op op)
+        {
+            switch(op)
+            {
+                case Op::Add: case Op::Sub: return 1;
+                case Op::Mul: case Op::Div: return 2;
+                case Op::Neg: return 3;
+                case Op::Pow: return 4;
+                default: return 0;
+            }
+        }
+        static bool rightAssoc(Op op) { return op == Op::Pow || op == Op::Neg; }
+
+        static double apply(Op op, double a, double b)
+        {
+            switch(op)
+            {
+                case Op::Add: return a + b;
+                case Op::Sub: return a - b;
+                case Op::Mul: return a * b;
+                case Op::Div: return a / b;
+                default: return pow(a, b);
+            }
+        }
+
+        // x^e for e = 0, 1, 2, the exponents where this equals pow(x, e) bit for bit
+        // (pow(x, 2) is correctly rounded, so it is x * x)
+        static double powi(double x, uint32_t e)
+        {
+            return e == 0 ? 1 : e == 1 ? x : x * x;
+        }
+
+        static void unary(Instr in, const double* __restrict a, double* __restrict out)
+        {
+            if(in.op == Op::Neg)
+                for(size_t i = 0; i < Batch; i++)
+                    out[i] = -a[i];
+            else if(in.arg == 2)
+                for(size_t i = 0; i < Batch; i++)
+                    out[i] = a[i] * a[i];
+            else
+                for(size_t i = 0; i < Batch; i++)
+                    out[i] = powi(a[i], in.arg);
+        }
+
+        static void binary(Op op, const double* __restrict a, const double* __restrict b, double* __restrict out)
+        {
+            switch(op)
+            {
+                case Op::Add: for(size_t i = 0; i < Batch; i++) out[i] = a[i] + b[i]; break;
+                case Op::Sub: for(size_t i = 0; i < Batch; i++) out[i] = a[i] - b[i]; break;
+                case Op::Mul: for(size_t i = 0; i < Batch; i++) out[i] = a[i] * b[i]; break;
+                case Op::Div: for(size_t i = 0; i < Batch; i++) out[i] = a[i] / b[i]; break;
+                default: for(size_t i = 0; i < Batch; i++) out[i] = pow(a[i], b[i]);
+            }
+        }
+
+        void emitConst(double v)
+        {
+            consts.push_back(v);
+            code.push_back({Op::Const, (uint32_t)consts.size() - 1});
+        }
+
+        // Appends an operator to the program, folding it if its operands are constants
+        void emit(Op op)
+        {
+            size_t n = code.size();
+            if(op == Op::Neg && code[n - 1].op == Op::Const)
+            {
+                consts[code[n - 1].arg] = -consts[code[n - 1].arg];
+                return;
+            }
+            if(op != Op::Neg && code[n - 1].op == Op::Const && code[n - 2].op == Op::Const)
+            {
+                double v = apply(op, consts[code[n - 2].arg], consts[code[n - 1].arg]);
+                consts.resize(consts.size() - 2);
+                code.resize(n - 2);
+                emitConst(v);
+                return;
+            }
+            // x ^ 0, 1, 2: no pow() call per row. Larger exponents keep pow(), since
+            // repeated squaring rounds differently and can overflow where pow does not.
+            if(op == Op::Pow && code[n - 1].op == Op::Const)
+            {
+                double e = consts[code[n - 1].arg];
+                if(e == 0 || e == 1 || e == 2)
+                {
+                    consts.pop_back();
+                    code[n - 1] = {Op::PowInt, (uint32_t)e};
+                    return;
+                }
+            }
+            code.push_back({op, 0});
+        }
+
+        void compile(string_view formula)
+        {
+            vector<Token> toks = tokenize(formula);
+            // Operator stack of the shunting-yard; an LParen entry is Op::Column
+            vector<pair<Op, size_t>> ops;
+            const Op paren = Op::Column;
+            int depth = 0; // values on the evaluation stack so far
+            bool expectOperand = true;
+            auto popOp = [&]() {
+                emit(ops.back().first);
+                depth -= ops.back().first == Op::Neg ? 0 : 1;
+                ops.pop_back();
+            };
+            for(const Token& t : toks)
+            {
+                if(expectOperand)
+                {
+                    if(t.kind == Tok::Number || t.kind == Tok::Ident)
+                    {
+                        if(t.kind == Tok::Number)
+                            emitConst(t.value);
+                        else
+                        {
+                            auto it = find(names.begin(), names.end(), t.text);
+                            if(it == names.end())
+                                it = names.insert(names.end(), string(t.text));
+                            code.push_back({Op::Column, (uint32_t)(it - names.begin())});
+                        }
+                        maxDepth = max(maxDepth, (size_t)++depth);
+                        expectOperand = false;
+                    }
+                    else if(t.kind == Tok::LParen)
+                        ops.push_back({paren, t.pos});
+                    else if(t.kind == Tok::Operator && t.text == "-")
+                        ops.push_back({Op::Neg, t.pos}); // prefix: pops nothing
+                    else if(!(t.kind == Tok::Operator && t.text == "+")) // unary plus is a no-op
+                        fail(t.kind == Tok::End ? "missing operand" : "expected operand", t.pos);
+                    continue;
+                }
+                if(t.kind == Tok::Operator)
+                {
+                    Op op = (Op)((int)Op::Add + (strchr("+-*/^", t.text[0]) - "+-*/^"));
+                    while(!ops.empty() && ops.back().first != paren
+                          && (prec(ops.back().first) > prec(op) || (prec(ops.back().first) == prec(op) && !rightAssoc(op))))
+                        popOp();
+                    ops.push_back({op, t.pos});
+                    expectOperand = true;
+                }
+                else if(t.kind == Tok::RParen)
+                {
+                    while(!ops.empty() && ops.back().first != paren)
+                        popOp();
+                    if(ops.empty())
+                        fail("unmatched ')'", t.pos);
+                    ops.pop_back();
+                }
+                else if(t.kind == Tok::End)
+                {
+                    while(!ops.empty())
+                    {
+                        if(ops.back().first == paren)
+                            fail("unmatched '('", ops.back().second);
+                        popOp();
+                    }
+                }
+                else
+                    fail("expected operator", t.pos);
+            }
+            maxDepth = max<size_t>(maxDepth, 1);
+        }
+};
+
+template<class F>
+double timeIt(F f)
+{
+    auto start = chrono::steady_clock::now();
+    f();
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv)
+{
+    // The example from geeksforgeeks/infixToPostfix.cpp
+    cout << Expression("a+b*(c^d-e)^(f+g*h)-i").postfix() << endl;
+    cout << Expression("-x^2 + 2 * (3 + 4) * rate_1").postfix() << endl;
+    for(const char* bad : {"a +", "(a + b", "a b", "a + 1.2.3", "a % b", "a * 1e999"})
+    {
+        try
+        {
+            Expression e(bad);
+        }
+        catch(const invalid_argument& err)
+        {
+            cout << "\"" << bad << "\": " << err.what() << endl;
+        }
+    }
+
+    size_t rows = argc > 1 ? atol(argv[1]) : 10000000;
+    mt19937_64 rng(49);
+    uniform_real_distribution<double> dist(0.5, 100);
+    unordered_map<string, vector<double>> table;
+    for(const char* col : {"price", "qty", "tax_rate", "discount"})
+    {
+        auto& v = table[col];
+        v.resize(rows);
+        for(auto& x : v)
+            x = dist(rng);
+    }
+    Expression e("price * qty * (1 + tax_rate / 100) - discount ^ 2 / (qty + 1)");
+    cout << "\n" << e.postfix() << endl;
+
+    vector<const double*> cols;
+    for(const string& name : e.variables())
+        cols.push_back(table[name].data());
+    vector<double> batched(rows), perRow(rows), direct(rows);
+    double tBatch = timeIt([&]() { e.evaluate(cols, rows, batched.data()); });
+    double tRow = timeIt([&]() {
+        for(size_t r = 0; r < rows; r++)
+            perRow[r] = e.evaluateRow(cols, r);
+    });
+    const double *p = table["price"].data(), *q = table["qty"].data(), *t = table["tax_rate"].data(), *d = table["discount"].data();
+    double tDirect = timeIt([&]() {
+        for(size_t r = 0; r < rows; r++)
+            direct[r] = p[r] * q[r] * (1 + t[r] / 100) - pow(d[r], 2) / (q[r] + 1);
+    });
+    cout << rows << " rows: per-row interpreter " << tRow << " s, batches of " << Expression::Batch << " "
+         << tBatch << " s, hand-written loop " << tDirect << " s" << endl;
+    // The engine and the per-row interpreter run the same operations, so they agree
+    // exactly. The compiler may fuse a * b - c in the hand-written loop into an
+    // FMA (e.g. with -march=native), so that one is compared with a tolerance.
+    bool ok = batched == perRow && e.evaluate(table) == batched;
+    for(size_t r = 0; r < rows; r++)
+        ok &= fabs(direct[r] - batched[r]) <= 1e-12 * max(1.0, fabs(direct[r]));
+    cout << (ok ? "results match" : "MISMATCH") << endl;
+    return 0;
+}
@@ -0,0 +1,183 @@
+// Static search trees for read-only sorted sets.
+//
+// sortedPrintingBST.cpp reads an array as an implicit tree (children of i at
+// 2*i+1 and 2*i+2) and walks it in order. Doing the opposite - writing a sorted
+// array back in that in-order walk - gives the Eytzinger layout, where a binary
+// search only ever moves down the tree and the hot top levels share cache lines.
+//
+//  - Eytzinger: the same layout stored 1-based (children of k at 2k and 2k+1,
+//    i.e. index i of sortedPrintingBST is k = i+1) so that the 16 descendants
+//    four levels below k sit in one 64 byte line at 16k, which is prefetched on
+//    every step. The loop is branchless; the answer is recovered from the final
+//    index by stripping the trailing right turns.
+//  - STree: a static B-tree with 16 keys per block (children of block k at
+//    k*17+i+1). Each block is one cache line and is searched with two AVX2
+//    compares + popcount (scalar count without -mavx2), so a lookup in 10^9 keys
+//    touches ~8 lines.
+//
+// Both return the smallest element >= x, or INT_MAX when there is none.
+// Usage: ./eytzingerSearch [N] [Q]  compares them with std::lower_bound.
+// Compile with -O2 -mavx2.
+#include <bits/stdc++.h>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+using namespace std;
+
+template<class T>
+struct AlignedBuffer
+{
+    T* data;
+    AlignedBuffer(size_t n) : data((T*)aligned_alloc(64, ((n * sizeof(T) + 63) / 64) * 64))
+    {
+        if(!data)
+            throw bad_alloc();
+    }
+    ~AlignedBuffer() { free(data); }
+    AlignedBuffer(const AlignedBuffer&) = delete;
+    AlignedBuffer& operator=(const AlignedBuffer&) = delete;
+};
+
+class Eytzinger
+{
+    public:
+        Eytzinger(const vector<int>& sorted) : n((int)sorted.size()), b(n + 1)
+        {
+            b.data[0] = INT_MAX; // returned when every element is < x
+            int t = 0;
+            build(sorted, t, 1);
+        }
+
+        int lowerBound(int x) const
+        {
+            // size_t: k * 16 and 2 * k + 1 would overflow int for n above 2^27
+            size_t k = 1;
+            while(k <= (size_t)n)
+            {
+                __builtin_prefetch(b.data + k * 16);
+                k = 2 * k + (b.data[k] < x);
+            }
+            // Undo the right turns taken after the last left turn
+            k >>= __builtin_ffsll(~k);
+            return b.data[k];
+        }
+
+    private:
+        int n;
+        AlignedBuffer<int> b;
+
+        // The in-order walk from printSorted, writing instead of printing
+        void build(const vector<int>& sorted, int& t, int k)
+        {
+            if(k > n)
+                return;
+            build(sorted, t, 2 * k);
+            b.data[k] = sorted[t++];
+            build(sorted, t, 2 * k + 1);
+        }
+};
+
+class STree
+{
+    public:
+        static const int B = 16;
+
+        STree(const vector<int>& sorted) : n((int)sorted.size()), blocks((n + B - 1) / B),
+                                           tree((size_t)max(blocks, 1) * B)
+        {
+            int t = 0;
+            build(sorted, t, 0);
+        }
+
+        int lowerBound(int x) const
+        {
+            int k = 0, res = INT_MAX;
+            while(k < blocks)
+            {
+                const int* keys = tree.data + (size_t)k * B;
+                int i = rank(keys, x);
+                if(i < B)
+                    res = keys[i];
+                k = child(k, i);
+            }
+            return res;
+        }
+
+    private:
+        int n, blocks;
+        AlignedBuffer<int> tree;
+
+        static int child(int k, int i) { return k * (B + 1) + i + 1; }
+
+        // Number of keys in the block that are < x; blocks are sorted and padded with INT_MAX
+        static int rank(const int* keys, int x)
+        {
+#ifdef __AVX2__
+            __m256i probe = _mm256_set1_epi32(x);
+            __m256i lo = _mm256_cmpgt_epi32(probe, _mm256_load_si256((const __m256i*)keys));
+            __m256i hi = _mm256_cmpgt_epi32(probe, _mm256_load_si256((const __m256i*)(keys + 8)));
+            unsigned mask = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(lo))
+                          | (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(hi)) << 8;
+            return __builtin_popcount(mask);
+#else
+            int below = 0;
+            for(int i = 0; i < B; i++)
+                below += keys[i] < x;
+            return below;
+#endif
+        }
+
+        void build(const vector<int>& sorted, int& t, int k)
+        {
+            if(k >= blocks)
+                return;
+            for(int i = 0; i < B; i++)
+            {
+                build(sorted, t, child(k, i));
+                tree.data[(size_t)k * B + i] = t < n ? sorted[t++] : INT_MAX;
+            }
+            build(sorted, t, child(k, B));
+        }
+};
+
+template<class F>
+double timeIt(F f)
+{
+    auto start = chrono::steady_clock::now();
+    f();
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv)
+{
+    int n = argc > 1 ? atoi(argv[1]) : 1 << 20;
+    int q = argc > 2 ? atoi(argv[2]) : 1 << 22;
+    mt19937 rng(2024);
+    vector<int> a(n);
+    for(auto& x : a)
+        x = (int)(rng() >> 1);
+    sort(a.begin(), a.end());
+    vector<int> queries(q);
+    for(auto& x : queries)
+        x = (int)(rng() >> 1);
+
+    Eytzinger eyt(a);
+    STree st(a);
+    long long sum[3] = {0, 0, 0};
+    double t0 = timeIt([&]() {
+        for(int x : queries)
+        {
+            auto it = lower_bound(a.begin(), a.end(), x);
+            sum[0] += it == a.end() ? INT_MAX : *it;
+        }
+    });
+    double t1 = timeIt([&]() { for(int x : queries) sum[1] += eyt.lowerBound(x); });
+    double t2 = timeIt([&]() { for(int x : queries) sum[2] += st.lowerBound(x); });
+
+    printf("n = %d, %d queries\n", n, q);
+    printf("std::lower_bound  %.3f s\n", t0);
+    printf("Eytzinger         %.3f s  (%.2fx)\n", t1, t0 / t1);
+    printf("S-tree            %.3f s  (%.2fx)\n", t2, t0 / t2);
+    printf(sum[0] == sum[1] && sum[1] == sum[2] ? "results match\n" : "MISMATCH\n");
+    return 0;
+}
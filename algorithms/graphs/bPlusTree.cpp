@@ -0,0 +1,420 @@
+// Arena allocated B+ tree as an ordered int -> int map.
+//
+// deleteNode.cpp keeps one malloc'd node per key in an unbalanced BST: sorted
+// inserts turn it into a linked list and every lookup is a chain of cache misses.
+// Here every node holds up to 32 keys, is aligned to a cache line and comes from
+// a bump allocated arena, so a lookup in 10^8 keys touches about 6 nodes.
+//
+//  - Key search inside a node counts the keys below the probe with AVX2
+//    compares (4 x 8 keys) when compiled with -mavx2, a plain counting loop the
+//    compiler can vectorise otherwise. Only the first `count` lanes are counted
+//    so every int is a valid key.
+//  - bulkLoad builds the tree bottom-up from sorted input in O(n).
+//  - rangeScan walks the leaf chain.
+//  - erase removes the key from its leaf without merging nodes, underfull
+//    leaves are simply left behind (the arena owns all memory anyway).
+//
+// Usage: ./bPlusTree [N]   benchmarks the BST from deleteNode.cpp, std::map and
+// the B+ tree on N random keys (default 10^6, the target workload is 10^8).
+// Compile with -O2 -mavx2.
+#include <bits/stdc++.h>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+using namespace std;
+
+class Arena
+{
+    public:
+        Arena(size_t blockSize = 1 << 22) : blockSize(blockSize), used(blockSize) {}
+        ~Arena()
+        {
+            for(char* b : blocks)
+                free(b);
+        }
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        template<class T>
+        T* make()
+        {
+            static_assert(alignof(T) <= 64, "arena blocks are cache line aligned");
+            size_t size = (sizeof(T) + 63) & ~size_t(63);
+            if(used + size > blockSize)
+            {
+                char* b = (char*)aligned_alloc(64, blockSize);
+                if(!b)
+                    throw bad_alloc();
+                blocks.push_back(b);
+                used = 0;
+            }
+            T* node = new (blocks.back() + used) T();
+            used += size;
+            return node;
+        }
+
+    private:
+        size_t blockSize, used;
+        vector<char*> blocks;
+};
+
+const int NODE_KEYS = 32;
+
+// Number of keys[0..count) that are < x (strict) or <= x
+template<bool orEqual>
+static inline int countBelow(const int* keys, int count, int x)
+{
+#ifdef __AVX2__
+    __m256i probe = _mm256_set1_epi32(x);
+    unsigned mask = 0;
+    for(int i = 0; i < NODE_KEYS; i += 8)
+    {
+        __m256i k = _mm256_load_si256((const __m256i*)(keys + i));
+        // orEqual: key <= x  <=>  !(key > x);  otherwise key < x  <=>  x > key
+        __m256i c = orEqual ? _mm256_cmpgt_epi32(k, probe) : _mm256_cmpgt_epi32(probe, k);
+        unsigned bits = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(c));
+        mask |= (orEqual ? ~bits & 0xffu : bits) << i;
+    }
+    if(count < 32)
+        mask &= (1u << count) - 1;
+    return __builtin_popcount(mask);
+#else
+    int below = 0;
+    for(int i = 0; i < count; i++)
+        below += orEqual ? keys[i] <= x : keys[i] < x;
+    return below;
+#endif
+}
+
+class BPlusTree
+{
+    public:
+        struct Leaf
+        {
+            alignas(64) int keys[NODE_KEYS];
+            int vals[NODE_KEYS];
+            Leaf* next;
+            int count;
+        };
+
+        struct Inner
+        {
+            // child[i] holds the keys in [keys[i-1], keys[i])
+            alignas(64) int keys[NODE_KEYS];
+            void* child[NODE_KEYS + 1];
+            int count;
+        };
+
+        BPlusTree() : root(arena.make<Leaf>()), height(0), size(0) {}
+
+        size_t entries() const { return size; }
+
+        const int* find(int key) const
+        {
+            const Leaf* leaf = findLeaf(key);
+            int i = countBelow<false>(leaf->keys, leaf->count, key);
+            return (i < leaf->count && leaf->keys[i] == key) ? &leaf->vals[i] : nullptr;
+        }
+
+        // Inserts or overwrites
+        void insert(int key, int val)
+        {
+            Inner* path[64];
+            int slot[64];
+            void* node = root;
+            for(int level = 0; level < height; level++)
+            {
+                Inner* in = (Inner*)node;
+                path[level] = in;
+                slot[level] = countBelow<true>(in->keys, in->count, key);
+                node = in->child[slot[level]];
+            }
+            Leaf* leaf = (Leaf*)node;
+            int i = countBelow<false>(leaf->keys, leaf->count, key);
+            if(i < leaf->count && leaf->keys[i] == key)
+            {
+                leaf->vals[i] = val;
+                return;
+            }
+            size++;
+            if(leaf->count < NODE_KEYS)
+            {
+                insertAt(leaf, i, key, val);
+                return;
+            }
+
+            // Split the full leaf in half and push the separator up the path
+            Leaf* right = arena.make<Leaf>();
+            int half = NODE_KEYS / 2;
+            right->count = NODE_KEYS - half;
+            copy(leaf->keys + half, leaf->keys + NODE_KEYS, right->keys);
+            copy(leaf->vals + half, leaf->vals + NODE_KEYS, right->vals);
+            leaf->count = half;
+            right->next = leaf->next;
+            leaf->next = right;
+            if(i <= half)
+                insertAt(leaf, i, key, val);
+            else
+                insertAt(right, i - half, key, val);
+
+            int sep = right->keys[0];
+            void* newChild = right;
+            for(int level = height - 1; level >= 0; level--)
+            {
+                Inner* in = path[level];
+                int s = slot[level];
+                if(in->count < NODE_KEYS)
+                {
+                    insertChild(in, s, sep, newChild);
+                    return;
+                }
+                // Split the inner node: keys[0..half) stay, keys[half] moves up
+                Inner* r = arena.make<Inner>();
+                int tmpKeys[NODE_KEYS + 1];
+                void* tmpChild[NODE_KEYS + 2];
+                copy(in->keys, in->keys + s, tmpKeys);
+                tmpKeys[s] = sep;
+                copy(in->keys + s, in->keys + NODE_KEYS, tmpKeys + s + 1);
+                copy(in->child, in->child + s + 1, tmpChild);
+                tmpChild[s + 1] = newChild;
+                copy(in->child + s + 1, in->child + NODE_KEYS + 1, tmpChild + s + 2);
+
+                int total = NODE_KEYS + 1, mid = total / 2;
+                in->count = mid;
+                copy(tmpKeys, tmpKeys + mid, in->keys);
+                copy(tmpChild, tmpChild + mid + 1, in->child);
+                r->count = total - mid - 1;
+                copy(tmpKeys + mid + 1, tmpKeys + total, r->keys);
+                copy(tmpChild + mid + 1, tmpChild + total + 1, r->child);
+                sep = tmpKeys[mid];
+                newChild = r;
+            }
+            Inner* top = arena.make<Inner>();
+            top->count = 1;
+            top->keys[0] = sep;
+            top->child[0] = root;
+            top->child[1] = newChild;
+            root = top;
+            height++;
+        }
+
+        bool erase(int key)
+        {
+            Leaf* leaf = findLeaf(key);
+            int i = countBelow<false>(leaf->keys, leaf->count, key);
+            if(i == leaf->count || leaf->keys[i] != key)
+                return false;
+            copy(leaf->keys + i + 1, leaf->keys + leaf->count, leaf->keys + i);
+            copy(leaf->vals + i + 1, leaf->vals + leaf->count, leaf->vals + i);
+            leaf->count--;
+            size--;
+            return true;
+        }
+
+        // Calls f(key, val) for every key in [lo, hi] in ascending order
+        template<class F>
+        void rangeScan(int lo, int hi, F f) const
+        {
+            const Leaf* leaf = findLeaf(lo);
+            int i = countBelow<false>(leaf->keys, leaf->count, lo);
+            for(; leaf; leaf = leaf->next, i = 0)
+                for(; i < leaf->count; i++)
+                {
+                    if(leaf->keys[i] > hi)
+                        return;
+                    f(leaf->keys[i], leaf->vals[i]);
+                }
+        }
+
+        // Replaces the contents with strictly increasing keys, leaves filled to `fill` keys
+        void bulkLoad(const vector<pair<int,int>>& sorted, int fill = NODE_KEYS)
+        {
+            fill = max(2, min(fill, NODE_KEYS));
+            vector<void*> level;
+            vector<int> lowKey;
+            Leaf* prev = nullptr;
+            for(size_t i = 0; i < sorted.size(); i += fill)
+            {
+                Leaf* leaf = arena.make<Leaf>();
+                leaf->count = (int)min(sorted.size() - i, (size_t)fill);
+                for(int k = 0; k < leaf->count; k++)
+                {
+                    leaf->keys[k] = sorted[i + k].first;
+                    leaf->vals[k] = sorted[i + k].second;
+                }
+                if(prev)
+                    prev->next = leaf;
+                prev = leaf;
+                level.push_back(leaf);
+                lowKey.push_back(leaf->keys[0]);
+            }
+            size = sorted.size();
+            height = 0;
+            if(level.empty())
+            {
+                root = arena.make<Leaf>();
+                return;
+            }
+            while(level.size() > 1)
+            {
+                vector<void*> up;
+                vector<int> upKey;
+                for(size_t i = 0; i < level.size(); )
+                {
+                    Inner* in = arena.make<Inner>();
+                    size_t end = min(level.size(), i + fill + 1);
+                    // Never leave a single orphan child for the next node
+                    if(level.size() - end == 1)
+                        end--;
+                    in->count = (int)(end - i - 1);
+                    for(size_t k = i; k < end; k++)
+                    {
+                        in->child[k - i] = level[k];
+                        if(k > i)
+                            in->keys[k - i - 1] = lowKey[k];
+                    }
+                    up.push_back(in);
+                    upKey.push_back(lowKey[i]);
+                    i = end;
+                }
+                level.swap(up);
+                lowKey.swap(upKey);
+                height++;
+            }
+            root = level[0];
+        }
+
+    private:
+        Arena arena;
+        void* root;
+        int height;
+        size_t size;
+
+        const Leaf* findLeaf(int key) const
+        {
+            const void* node = root;
+            for(int level = 0; level < height; level++)
+            {
+                const Inner* in = (const Inner*)node;
+                node = in->child[countBelow<true>(in->keys, in->count, key)];
+            }
+            return (const Leaf*)node;
+        }
+
+        Leaf* findLeaf(int key)
+        {
+            return const_cast<Leaf*>(static_cast<const BPlusTree*>(this)->findLeaf(key));
+        }
+
+        static void insertAt(Leaf* leaf, int i, int key, int val)
+        {
+            copy_backward(leaf->keys + i, leaf->keys + leaf->count, leaf->keys + leaf->count + 1);
+            copy_backward(leaf->vals + i, leaf->vals + leaf->count, leaf->vals + leaf->count + 1);
+            leaf->keys[i] = key;
+            leaf->vals[i] = val;
+            leaf->count++;
+        }
+
+        static void insertChild(Inner* in, int s, int sep, void* child)
+        {
+            copy_backward(in->keys + s, in->keys + in->count, in->keys + in->count + 1);
+            copy_backward(in->child + s + 1, in->child + in->count + 1, in->child + in->count + 2);
+            in->keys[s] = sep;
+            in->child[s + 1] = child;
+            in->count++;
+        }
+};
+
+// The BST from deleteNode.cpp, kept as the benchmark baseline
+struct node
+{
+    int key;
+    struct node *left, *right;
+};
+
+struct node *newNode(int item)
+{
+    struct node *temp = (struct node *)malloc(sizeof(struct node));
+    temp->key = item;
+    temp->left = temp->right = NULL;
+    return temp;
+}
+
+struct node* insert(struct node* node, int key)
+{
+    if (node == NULL) return newNode(key);
+    if (key < node->key)
+        node->left = insert(node->left, key);
+    else
+        node->right = insert(node->right, key);
+    return node;
+}
+
+bool search(struct node* root, int key)
+{
+    while(root != NULL && root->key != key)
+        root = key < root->key ? root->left : root->right;
+    return root != NULL;
+}
+
+template<class F>
+double timeIt(F f)
+{
+    auto start = chrono::steady_clock::now();
+    f();
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv)
+{
+    size_t n = argc > 1 ? strtoull(argv[1], NULL, 10) : 1000000;
+    mt19937 rng(12345);
+    vector<int> keys(n), probes(n);
+    for(auto& k : keys)
+        k = (int)rng();
+    for(auto& p : probes)
+        p = keys[rng() % n];
+
+    long long hits = 0;
+    printf("%zu random keys, %zu lookups (seconds)\n", n, n);
+
+    {
+        // Sorted input would make this BST a linked list, so it only gets random keys
+        struct node* root = NULL;
+        double ins = timeIt([&]() { for(int k : keys) root = insert(root, k); });
+        double look = timeIt([&]() { for(int p : probes) hits += search(root, p); });
+        printf("BST (deleteNode.cpp)  insert %.3f  lookup %.3f\n", ins, look);
+    }
+    {
+        map<int,int> m;
+        double ins = timeIt([&]() { for(int k : keys) m[k] = k; });
+        double look = timeIt([&]() { for(int p : probes) hits += m.count(p); });
+        printf("std::map              insert %.3f  lookup %.3f\n", ins, look);
+    }
+    {
+        BPlusTree t;
+        double ins = timeIt([&]() { for(int k : keys) t.insert(k, k); });
+        double look = timeIt([&]() { for(int p : probes) hits += t.find(p) != nullptr; });
+        printf("B+ tree               insert %.3f  lookup %.3f\n", ins, look);
+    }
+    {
+        vector<pair<int,int>> sorted;
+        double prep = timeIt([&]() {
+            vector<int> s(keys);
+            sort(s.begin(), s.end());
+            s.erase(unique(s.begin(), s.end()), s.end());
+            sorted.reserve(s.size());
+            for(int k : s)
+                sorted.push_back({k, k});
+        });
+        BPlusTree t;
+        double load = timeIt([&]() { t.bulkLoad(sorted); });
+        double look = timeIt([&]() { for(int p : probes) hits += t.find(p) != nullptr; });
+        long long scanned = 0;
+        double scan = timeIt([&]() { t.rangeScan(INT_MIN, INT_MAX, [&](int, int v) { scanned += v; }); });
+        printf("B+ tree bulk load     sort %.3f  load %.3f  lookup %.3f  full scan %.3f\n", prep, load, look, scan);
+        hits += scanned & 1;
+    }
+    printf("(checksum %lld)\n", hits);
+    return 0;
+}
@@ -0,0 +1,411 @@
+// Bipartiteness check over a CSR (compressed sparse row) graph.
+//
+// Same input as ESO207/PA3/bipartiteGraph.cpp (t test cases of "V E" followed by
+// E edges over vertices 1..V), but every buffer is sized from the input so it
+// scales to ~10^8 edges. Prints "Yes", or "No" followed by the length and the
+// vertices of an odd cycle which certifies that the graph is not bipartite.
+//
+//  1. Components are found with a lock-free union-find over edge ranges split
+//     between threads.
+//  2. Each component is 2-coloured by an independent BFS; threads take component
+//     roots from a shared counter so no two threads ever touch the same vertex.
+//  3. If a component has a monochromatic edge (u,v), the BFS tree paths from u
+//     and v to their common ancestor plus (u,v) form an odd cycle. This is the
+//     default certificate and costs nothing beyond the colouring.
+//  4. Optionally (--shortest) a shortest odd cycle: a pruned BFS from every
+//     vertex of every non-bipartite component, split between threads and sharing
+//     the best length found so far. For the minimising root r a shortest odd
+//     cycle is r -> u, (u,v), v -> r with dist(r,u) == dist(r,v), so a search
+//     stops as soon as 2*depth+1 >= best. Worst case O(V * E): fine for
+//     moderate graphs, not for 10^8 edges.
+//
+// Usage: ./bipartiteCSR [--shortest] < input     ./bipartiteCSR --check
+// Compile with -O2 -pthread.
+#include <bits/stdc++.h>
+using namespace std;
+
+struct CSRGraph
+{
+    int V;
+    vector<long long> offset; // size V+1
+    vector<int> adj;          // size 2E
+
+    // Builds an undirected CSR graph from an edge list with a counting pass
+    CSRGraph(int V, const vector<pair<int,int>>& edges) : V(V), offset(V+1, 0), adj(2*edges.size())
+    {
+        for(auto& e : edges)
+        {
+            offset[e.first+1]++;
+            offset[e.second+1]++;
+        }
+        for(int i = 0; i < V; i++)
+            offset[i+1] += offset[i];
+        vector<long long> pos(offset.begin(), offset.end()-1);
+        for(auto& e : edges)
+        {
+            adj[pos[e.first]++] = e.second;
+            adj[pos[e.second]++] = e.first;
+        }
+    }
+};
+
+struct BipartiteResult
+{
+    bool bipartite;
+    vector<int> color;    // 0/1 side per vertex when bipartite
+    vector<int> oddCycle; // an odd cycle (shortest if asked for), in order, when not bipartite
+};
+
+class BipartiteChecker
+{
+    public:
+        BipartiteChecker(const CSRGraph& g, int threads) : g(g), threads(max(1, threads)), parent(g.V) {}
+
+        BipartiteResult run(bool shortestCertificate = false)
+        {
+            BipartiteResult res;
+            findComponents();
+
+            res.color.assign(g.V, -1);
+            vector<int> depth(g.V, 0), bfsParent(g.V, -1);
+            // Every non-bipartite component root, and the conflicting edge with the
+            // smallest depth[u] + depth[v] (any one gives a valid certificate)
+            mutex conflictLock;
+            vector<int> conflictRoots;
+            long long bestBound = LLONG_MAX;
+            int cu = -1, cv = -1;
+
+            atomic<int> next(0);
+            const int CHUNK = 4096;
+            parallelFor([&](int) {
+                vector<int> queue;
+                while(true)
+                {
+                    int lo = next.fetch_add(CHUNK);
+                    if(lo >= g.V)
+                        break;
+                    int hi = min(g.V, lo + CHUNK);
+                    for(int r = lo; r < hi; r++)
+                    {
+                        if(parent[r].load(memory_order_relaxed) != r)
+                            continue;
+                        int u, v;
+                        if(colorComponent(r, res.color, depth, bfsParent, queue, u, v))
+                            continue;
+                        long long bound = (long long)depth[u] + depth[v] + 1;
+                        lock_guard<mutex> guard(conflictLock);
+                        conflictRoots.push_back(r);
+                        if(bound < bestBound)
+                            bestBound = bound, cu = u, cv = v;
+                    }
+                }
+            });
+
+            res.bipartite = conflictRoots.empty();
+            if(res.bipartite)
+                return res;
+            res.color.clear();
+            res.oddCycle = joinPaths(cu, cv, bfsParent, depth);
+            if(shortestCertificate)
+                shortestOddCycle(conflictRoots, res.oddCycle);
+            return res;
+        }
+
+    private:
+        const CSRGraph& g;
+        int threads;
+        vector<atomic<int>> parent;
+
+        template<class F>
+        void parallelFor(F f)
+        {
+            vector<thread> pool;
+            for(int t = 1; t < threads; t++)
+                pool.emplace_back(f, t);
+            f(0);
+            for(auto& th : pool)
+                th.join();
+        }
+
+        int findRoot(int v)
+        {
+            while(true)
+            {
+                int p = parent[v].load(memory_order_relaxed);
+                if(p == v)
+                    return v;
+                int gp = parent[p].load(memory_order_relaxed);
+                // Path halving; a failed CAS only means someone else shortened it
+                parent[v].compare_exchange_weak(p, gp, memory_order_relaxed);
+                v = gp;
+            }
+        }
+
+        void unite(int a, int b)
+        {
+            while(true)
+            {
+                a = findRoot(a);
+                b = findRoot(b);
+                if(a == b)
+                    return;
+                // Always hang the larger index below the smaller one so roots stay canonical
+                if(a < b)
+                    swap(a, b);
+                int expected = a;
+                if(parent[a].compare_exchange_strong(expected, b, memory_order_relaxed))
+                    return;
+            }
+        }
+
+        void findComponents()
+        {
+            for(int i = 0; i < g.V; i++)
+                parent[i].store(i, memory_order_relaxed);
+            parallelFor([&](int t) {
+                long long lo = (long long)g.V * t / threads, hi = (long long)g.V * (t+1) / threads;
+                for(long long u = lo; u < hi; u++)
+                    for(long long k = g.offset[u]; k < g.offset[u+1]; k++)
+                        if(g.adj[k] < u)
+                            unite((int)u, g.adj[k]);
+            });
+            parallelFor([&](int t) {
+                long long lo = (long long)g.V * t / threads, hi = (long long)g.V * (t+1) / threads;
+                for(long long u = lo; u < hi; u++)
+                    parent[u].store(findRoot((int)u), memory_order_relaxed);
+            });
+        }
+
+        // BFS 2-colouring of the component of r. Returns false and the
+        // monochromatic edge with the smallest depth sum on conflict.
+        bool colorComponent(int r, vector<int>& color, vector<int>& depth, vector<int>& bfsParent,
+                            vector<int>& queue, int& cu, int& cv)
+        {
+            queue.clear();
+            queue.push_back(r);
+            color[r] = 0;
+            depth[r] = 0;
+            bool ok = true;
+            for(size_t head = 0; head < queue.size(); head++)
+            {
+                int u = queue[head];
+                for(long long k = g.offset[u]; k < g.offset[u+1]; k++)
+                {
+                    int v = g.adj[k];
+                    if(color[v] == -1)
+                    {
+                        color[v] = color[u] ^ 1;
+                        depth[v] = depth[u] + 1;
+                        bfsParent[v] = u;
+                        queue.push_back(v);
+                    }
+                    else if(color[v] == color[u] && (ok || depth[u] + depth[v] < depth[cu] + depth[cv]))
+                    {
+                        ok = false;
+                        cu = u, cv = v;
+                    }
+                }
+            }
+            return ok;
+        }
+
+        // Cycle formed by the edge (u,v) and the tree paths from u and v to their common ancestor
+        static vector<int> joinPaths(int u, int v, const vector<int>& par, const vector<int>& depth)
+        {
+            vector<int> left, right;
+            while(depth[u] > depth[v])
+                left.push_back(u), u = par[u];
+            while(depth[v] > depth[u])
+                right.push_back(v), v = par[v];
+            while(u != v)
+            {
+                left.push_back(u), u = par[u];
+                right.push_back(v), v = par[v];
+            }
+            left.push_back(u);
+            left.insert(left.end(), right.rbegin(), right.rend());
+            return left;
+        }
+
+        // Improves best to a shortest odd cycle over all the given components.
+        // dist/par are allocated once per thread and reset through touched.
+        void shortestOddCycle(const vector<int>& roots, vector<int>& best)
+        {
+            vector<char> searched(g.V, 0);
+            for(int r : roots)
+                searched[r] = 1;
+            vector<int> members;
+            for(int v = 0; v < g.V; v++)
+                if(searched[parent[v].load(memory_order_relaxed)])
+                    members.push_back(v);
+
+            atomic<int> bestLen((int)best.size());
+            atomic<size_t> next(0);
+            mutex bestLock;
+            parallelFor([&](int) {
+                vector<int> dist(g.V, -1), par(g.V, -1), touched, queue;
+                while(true)
+                {
+                    size_t i = next.fetch_add(1);
+                    if(i >= members.size() || bestLen.load() == 1)
+                        break;
+                    int r = members[i];
+                    queue.assign(1, r);
+                    dist[r] = 0;
+                    touched.assign(1, r);
+                    int bu = -1, bv = -1;
+                    for(size_t head = 0; head < queue.size() && bu == -1; head++)
+                    {
+                        int u = queue[head];
+                        // Any odd cycle found from here on has length >= 2*dist[u]+1
+                        if(2*dist[u] + 1 >= bestLen.load(memory_order_relaxed))
+                            break;
+                        for(long long k = g.offset[u]; k < g.offset[u+1]; k++)
+                        {
+                            int v = g.adj[k];
+                            if(dist[v] == -1)
+                            {
+                                dist[v] = dist[u] + 1;
+                                par[v] = u;
+                                queue.push_back(v);
+                                touched.push_back(v);
+                            }
+                            else if(dist[v] == dist[u])
+                            {
+                                bu = u, bv = v;
+                                break;
+                            }
+                        }
+                    }
+                    if(bu != -1)
+                    {
+                        vector<int> cycle = joinPaths(bu, bv, par, dist);
+                        lock_guard<mutex> guard(bestLock);
+                        if((int)cycle.size() < bestLen.load())
+                        {
+                            best = cycle;
+                            bestLen.store((int)cycle.size());
+                        }
+                    }
+                    for(int v : touched)
+                        dist[v] = -1;
+                }
+            });
+        }
+};
+
+// fread based reader, scanf is far too slow for 10^8 edges
+static char buf[1 << 16];
+static size_t bufLen = 0, bufPos = 0;
+
+bool readInt(int& x)
+{
+    int c;
+    auto next = [&]() -> int {
+        if(bufPos == bufLen)
+        {
+            bufLen = fread(buf, 1, sizeof(buf), stdin);
+            bufPos = 0;
+            if(bufLen == 0)
+                return -1;
+        }
+        return buf[bufPos++];
+    };
+    do
+        c = next();
+    while(c != -1 && c != '-' && (c < '0' || c > '9'));
+    if(c == -1)
+        return false;
+    bool neg = (c == '-');
+    if(neg)
+        c = next();
+    x = 0;
+    for(; c >= '0' && c <= '9'; c = next())
+        x = x*10 + (c - '0');
+    if(neg)
+        x = -x;
+    return true;
+}
+
+// Built-in regression graphs: (V, edges, expected shortest odd cycle length or 0)
+static bool selfCheck(int threads)
+{
+    struct Case { int V; vector<pair<int,int>> edges; int shortest; };
+    vector<Case> cases;
+    // A 5-cycle, then a long path ending in a triangle: the triangle's component
+    // has the larger BFS depths but holds the shortest odd cycle
+    Case c{18, {{1,2},{2,3},{3,4},{4,5},{5,1}}, 3};
+    for(int v = 6; v < 16; v++)
+        c.edges.push_back({v, v+1});
+    c.edges.insert(c.edges.end(), {{16,17},{17,18},{18,16}});
+    cases.push_back(c);
+    cases.push_back({4, {{1,2},{2,3},{3,4},{4,1}}, 0});
+    cases.push_back({7, {{1,2},{2,3},{3,4},{4,5},{5,6},{6,7},{7,1}}, 7});
+
+    bool ok = true;
+    for(auto& tc : cases)
+    {
+        CSRGraph graph(tc.V + 1, tc.edges);
+        for(bool shortest : {false, true})
+        {
+            BipartiteResult res = BipartiteChecker(graph, threads).run(shortest);
+            bool good = res.bipartite == (tc.shortest == 0);
+            if(!res.bipartite)
+            {
+                // The certificate is a closed walk of odd length over real edges
+                set<pair<int,int>> edgeSet;
+                for(auto& e : tc.edges)
+                    edgeSet.insert(minmax(e.first, e.second));
+                size_t len = res.oddCycle.size();
+                good &= len % 2 == 1 && (!shortest || (int)len == tc.shortest);
+                for(size_t i = 0; i < len; i++)
+                    good &= edgeSet.count(minmax(res.oddCycle[i], res.oddCycle[(i+1) % len])) > 0;
+            }
+            printf("V = %d, %s: %s\n", tc.V, shortest ? "shortest" : "any", good ? "ok" : "WRONG");
+            ok &= good;
+        }
+    }
+    return ok;
+}
+
+int main(int argc, char** argv)
+{
+    int threads = max(1u, thread::hardware_concurrency());
+    bool shortest = false;
+    for(int i = 1; i < argc; i++)
+    {
+        if(!strcmp(argv[i], "--check"))
+            return selfCheck(threads) ? 0 : 1;
+        if(!strcmp(argv[i], "--shortest"))
+            shortest = true;
+    }
+    int t;
+    if(!readInt(t))
+        return 0;
+    while(t--)
+    {
+        int v, e;
+        readInt(v);
+        readInt(e);
+        vector<pair<int,int>> edges(e);
+        for(auto& ed : edges)
+        {
+            readInt(ed.first);
+            readInt(ed.second);
+        }
+        // Vertices are 1-indexed in the input, keep vertex 0 as an isolated dummy
+        CSRGraph graph(v+1, edges);
+        vector<pair<int,int>>().swap(edges);
+
+        BipartiteResult res = BipartiteChecker(graph, threads).run(shortest);
+        if(res.bipartite)
+            printf("Yes\n");
+        else
+        {
+            printf("No\n%d\n", (int)res.oddCycle.size());
+            for(size_t i = 0; i < res.oddCycle.size(); i++)
+                printf("%d%c", res.oddCycle[i], i+1 == res.oddCycle.size() ? '\n' : ' ');
+        }
+    }
+    return 0;
+}
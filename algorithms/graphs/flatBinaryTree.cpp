@@ -0,0 +1,340 @@
+// Flat (structure of arrays) binary tree and tree DPs as linear sweeps.
+//
+// closestNodeToGiven_JPMC.cpp, distanceStartNodeLeafNode_wellsFargo.cpp,
+// vertexCoverDP_JPMC.cpp and Tree-Traversal.cpp all chase Node* pointers that
+// were allocated one by one. FlatTree keeps the same tree as parallel arrays
+// left/right/parent/val stored in preorder, which gives two properties:
+//
+//  - every child has a larger index than its parent, so a bottom-up DP is one
+//    loop from n-1 down to 0 and a top-down DP one loop from 0 up to n-1
+//  - the subtree of v is the contiguous range [v, v + size[v])
+//
+// A missing child is stored as index n, a sentinel slot whose DP values are
+// chosen so the recurrences need no branches (0 for cover sizes and gains, 1
+// for products, "infinity" for leaf distances). The sweeps below are plain
+// loads/min/max/adds over arrays that stream through the cache. ClosestLeafIndex
+// precomputes the nearest leaf of every node so repeated queries are O(1).
+#include <bits/stdc++.h>
+using namespace std;
+
+typedef long long ll;
+
+struct Node
+{
+    int key;
+    struct Node* left, *right;
+};
+
+Node* newNode(int key)
+{
+    Node* temp = new Node;
+    temp->key = key;
+    temp->left = temp->right = NULL;
+    return (temp);
+}
+
+struct FlatTree
+{
+    int n;
+    vector<int> left, right, parent, size; // size n+1, index n is the null sentinel
+    vector<int> val;
+    vector<Node*> origin; // the pointer node each slot was flattened from
+    unordered_map<Node*,int> ids; // and back, filled by the first id() call
+
+    // Flattens a pointer tree in preorder without recursion
+    FlatTree(Node* root)
+    {
+        vector<Node*> order;
+        vector<int> par;
+        vector<pair<Node*,int>> st;
+        if(root)
+            st.push_back({root, -1});
+        while(!st.empty())
+        {
+            Node* u = st.back().first;
+            int p = st.back().second;
+            st.pop_back();
+            int id = (int)order.size();
+            order.push_back(u);
+            par.push_back(p);
+            if(u->right)
+                st.push_back({u->right, id});
+            if(u->left)
+                st.push_back({u->left, id});
+        }
+        n = (int)order.size();
+        origin = order;
+        left.assign(n+1, n);
+        right.assign(n+1, n);
+        parent.assign(n+1, n);
+        size.assign(n+1, 0);
+        val.assign(n+1, 0);
+        for(int i = 0; i < n; i++)
+        {
+            val[i] = order[i]->key;
+            parent[i] = par[i] == -1 ? n : par[i];
+        }
+        for(int i = 1; i < n; i++)
+        {
+            Node* p = order[par[i]];
+            (p->left == order[i] ? left : right)[par[i]] = i;
+        }
+        for(int v = n-1; v >= 0; v--)
+            size[v] = 1 + size[left[v]] + size[right[v]];
+    }
+
+    bool isLeaf(int v) const { return left[v] == n && right[v] == n; }
+
+    // Slot of a pointer node, -1 if it is not in this tree. Flattening does not
+    // build ids, so trees that are only swept never pay for the hashing.
+    int id(Node* u)
+    {
+        if(ids.empty() && n > 0)
+        {
+            ids.reserve(n);
+            for(int i = 0; i < n; i++)
+                ids[origin[i]] = i;
+        }
+        auto it = ids.find(u);
+        return it == ids.end() ? -1 : it->second;
+    }
+};
+
+// vertexCoverDP_JPMC.cpp: incl[v] = 1 + sum min(incl, excl) of children,
+// excl[v] = sum incl of children. A lone root needs no cover.
+int vertexCover(const FlatTree& t)
+{
+    if(t.n <= 1)
+        return 0;
+    vector<int> incl(t.n+1, 0), excl(t.n+1, 0);
+    for(int v = t.n-1; v >= 0; v--)
+    {
+        int l = t.left[v], r = t.right[v];
+        incl[v] = 1 + min(incl[l], excl[l]) + min(incl[r], excl[r]);
+        excl[v] = incl[l] + incl[r];
+    }
+    return min(incl[0], excl[0]);
+}
+
+// maxPathSum.cpp: best downward gain per node, best path bending at each node
+ll maxPathSum(const FlatTree& t)
+{
+    vector<ll> gain(t.n+1, 0);
+    ll best = LLONG_MIN;
+    for(int v = t.n-1; v >= 0; v--)
+    {
+        ll l = max(gain[t.left[v]], 0LL), r = max(gain[t.right[v]], 0LL);
+        best = max(best, t.val[v] + l + r);
+        gain[v] = t.val[v] + max(l, r);
+    }
+    return best;
+}
+
+// maxPathProduct.cpp: hi/lo are the largest/smallest products of a downward path
+// starting at v. A child contributes one of {1 (not taken), hi, lo}; the sentinel
+// has hi = lo = 1 so a missing child is the same as not taking it. Products
+// saturate at LLONG_MIN / LLONG_MAX instead of overflowing (a path of 64 nodes
+// with value 2 is already out of range); the sign of a saturated value is right,
+// so it still orders correctly against the others.
+static ll satMul(ll a, ll b)
+{
+    ll r;
+    if(__builtin_mul_overflow(a, b, &r))
+        return (a < 0) != (b < 0) ? LLONG_MIN : LLONG_MAX;
+    return r;
+}
+
+ll maxPathProduct(const FlatTree& t)
+{
+    vector<ll> hi(t.n+1, 1), lo(t.n+1, 1);
+    ll best = LLONG_MIN;
+    for(int v = t.n-1; v >= 0; v--)
+    {
+        int l = t.left[v], r = t.right[v];
+        ll x = t.val[v];
+        ll ext[2][3] = {{1, hi[l], lo[l]}, {1, hi[r], lo[r]}};
+        ll down_hi = LLONG_MIN, down_lo = LLONG_MAX;
+        for(int a = 0; a < 3; a++)
+        {
+            ll viaL = satMul(x, ext[0][a]), viaR = satMul(x, ext[1][a]);
+            down_hi = max({down_hi, viaL, viaR});
+            down_lo = min({down_lo, viaL, viaR});
+            for(int b = 0; b < 3; b++)
+                best = max(best, satMul(viaL, ext[1][b]));
+        }
+        hi[v] = down_hi;
+        lo[v] = down_lo;
+    }
+    return best;
+}
+
+// closestNodeToGiven_JPMC.cpp / distanceStartNodeLeafNode_wellsFargo.cpp answered for
+// every node at once. A bottom-up sweep finds the nearest leaf below each node, a
+// top-down sweep then lets each node take its parent's answer + 1 when that is
+// closer (rerooting), so building is O(n) and every query is one array load.
+class ClosestLeafIndex
+{
+    public:
+        struct Entry { int dist, leaf; }; // kept together: one cache line per lookup
+
+        ClosestLeafIndex(const FlatTree& t) : entry(t.n + 1)
+        {
+            const int INF = INT_MAX / 2;
+            entry[t.n] = {INF, -1};
+            for(int v = t.n-1; v >= 0; v--)
+            {
+                if(t.isLeaf(v))
+                {
+                    entry[v] = {0, v};
+                    continue;
+                }
+                const Entry& l = entry[t.left[v]];
+                const Entry& r = entry[t.right[v]];
+                entry[v] = l.dist <= r.dist ? Entry{l.dist + 1, l.leaf} : Entry{r.dist + 1, r.leaf};
+            }
+            // Parents come first in preorder, so entry[parent] is already final here
+            for(int v = 1; v < t.n; v++)
+            {
+                const Entry& up = entry[t.parent[v]];
+                if(up.dist + 1 < entry[v].dist)
+                    entry[v] = {up.dist + 1, up.leaf};
+            }
+            entry.pop_back();
+        }
+
+        int distance(int v) const { return entry[v].dist; }
+        int leaf(int v) const { return entry[v].leaf; }
+
+        // Answers k queries; lookups are prefetched a few iterations ahead since
+        // query nodes are usually scattered over the tree
+        void query(const int* nodes, size_t k, int* dist, int* leafOut) const
+        {
+            const size_t AHEAD = 16;
+            for(size_t i = 0; i < k; i++)
+            {
+                if(i + AHEAD < k)
+                    __builtin_prefetch(&entry[nodes[i + AHEAD]]);
+                const Entry& e = entry[nodes[i]];
+                dist[i] = e.dist;
+                leafOut[i] = e.leaf;
+            }
+        }
+
+    private:
+        vector<Entry> entry;
+};
+
+// Pointer-chasing versions used as the baseline
+int vCoverPtr(Node* root, unordered_map<Node*,int>& memo)
+{
+    if(!root || (!root->left && !root->right))
+        return 0;
+    auto it = memo.find(root);
+    if(it != memo.end())
+        return it->second;
+    int incl = 1 + vCoverPtr(root->left, memo) + vCoverPtr(root->right, memo);
+    int excl = 0;
+    if(root->left)
+        excl += 1 + vCoverPtr(root->left->left, memo) + vCoverPtr(root->left->right, memo);
+    if(root->right)
+        excl += 1 + vCoverPtr(root->right->left, memo) + vCoverPtr(root->right->right, memo);
+    return memo[root] = min(incl, excl);
+}
+
+ll maxGainPtr(Node* root, ll& best)
+{
+    if(!root)
+        return 0;
+    ll l = max(maxGainPtr(root->left, best), 0LL);
+    ll r = max(maxGainPtr(root->right, best), 0LL);
+    best = max(best, root->key + l + r);
+    return root->key + max(l, r);
+}
+
+template<class F>
+double timeIt(F f)
+{
+    auto start = chrono::steady_clock::now();
+    f();
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv)
+{
+    // The tree from vertexCoverDP_JPMC.cpp
+    Node *root = newNode(20);
+    root->left = newNode(8);
+    root->left->left = newNode(4);
+    root->left->right = newNode(12);
+    root->left->right->left = newNode(10);
+    root->left->right->right = newNode(14);
+    root->right = newNode(22);
+    root->right->right = newNode(25);
+    FlatTree small(root);
+    printf("Size of the smallest vertex cover is %d\n", vertexCover(small));
+
+    // The tree from maxPathProduct.cpp
+    Node* p = newNode(3);
+    p->left = newNode(-2);
+    p->right = newNode(4);
+    p->left->left = newNode(5);
+    p->left->right = newNode(0);
+    p->left->right->left = newNode(1);
+    p->right->left = newNode(-2);
+    p->right->right = newNode(2);
+    printf("Max path product is %lld\n", maxPathProduct(FlatTree(p)));
+
+    // The tree from closestNodeToGiven_JPMC.cpp, x = root->right
+    Node* c = newNode(1);
+    c->left = newNode(12);
+    c->right = newNode(13);
+    c->right->left = newNode(14);
+    c->right->right = newNode(15);
+    c->right->left->left = newNode(21);
+    c->right->left->right = newNode(22);
+    c->right->right->left = newNode(23);
+    c->right->right->right = newNode(24);
+    FlatTree ct(c);
+    ClosestLeafIndex index(ct);
+    int x = ct.id(c->right);
+    printf("The closest leaf to the node with value %d is %d at a distance of %d\n",
+           ct.val[x], ct.val[index.leaf(x)], index.distance(x));
+
+    // Random tree benchmark, nodes attached at random free slots
+    int n = argc > 1 ? atoi(argv[1]) : 1000000;
+    mt19937 rng(7);
+    vector<Node*> nodes;
+    nodes.push_back(newNode((int)(rng() % 201) - 100));
+    for(int i = 1; i < n; i++)
+    {
+        Node* u = nodes[rng() % nodes.size()];
+        while(u->left && u->right)
+            u = (rng() & 1) ? u->left : u->right;
+        Node* c = newNode((int)(rng() % 201) - 100);
+        ((!u->left && (rng() & 1)) || u->right ? u->left : u->right) = c;
+        nodes.push_back(c);
+    }
+    FlatTree* flat = nullptr;
+    double tFlatten = timeIt([&]() { flat = new FlatTree(nodes[0]); });
+
+    int vcFlat = 0, vcPtr = 0;
+    ll sumFlat = 0, sumPtr = LLONG_MIN;
+    double t1 = timeIt([&]() { vcFlat = vertexCover(*flat); });
+    double t2 = timeIt([&]() { sumFlat = maxPathSum(*flat); });
+    ClosestLeafIndex* leaves = nullptr;
+    double t3 = timeIt([&]() { leaves = new ClosestLeafIndex(*flat); });
+    vector<int> queries(n), qDist(n), qLeaf(n);
+    for(auto& q : queries)
+        q = (int)(rng() % n);
+    double t6 = timeIt([&]() { leaves->query(queries.data(), n, qDist.data(), qLeaf.data()); });
+    double t4 = timeIt([&]() { unordered_map<Node*,int> memo; vcPtr = vCoverPtr(nodes[0], memo); });
+    double t5 = timeIt([&]() { maxGainPtr(nodes[0], sumPtr); });
+
+    printf("\n%d random nodes (flatten %.3f s)\n", n, tFlatten);
+    printf("vertex cover   flat %.4f s  pointer %.4f s  (%d / %d)\n", t1, t4, vcFlat, vcPtr);
+    printf("max path sum   flat %.4f s  pointer %.4f s  (%lld / %lld)\n", t2, t5, sumFlat, sumPtr);
+    printf("closest leaf   index build %.4f s, %d batch queries %.4f s\n", t3, n, t6);
+    delete leaves;
+    delete flat;
+    return 0;
+}
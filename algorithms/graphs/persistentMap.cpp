@@ -0,0 +1,368 @@
+// Persistent (immutable) ordered map with structural sharing.
+//
+// deleteNode.cpp changes its BST in place, so a reader walking the tree has to
+// block the writer. PersistentMap never changes a node after it is built:
+// insert and erase copy only the O(log n) nodes on the search path and share
+// every other subtree with the old version. A version is just a root pointer,
+// so taking a snapshot is O(1) and a snapshot never changes.
+//
+//  - Balance: a treap whose priority is a hash of the key, so no random state
+//    is needed and equal key sets always get the same shape.
+//  - Reclamation: every node has an atomic reference count (one per parent and
+//    one per map holding it as root). When the last version using a node goes
+//    away the node is freed, iteratively so long chains cannot overflow the stack.
+//  - SharedMap publishes the "current" version to many threads. Readers take a
+//    snapshot without locking: the root is protected by a hazard pointer between
+//    loading it and bumping its count. Writers are serialised by a mutex and
+//    only release an old root once no reader has it in a hazard slot.
+#include <bits/stdc++.h>
+using namespace std;
+
+static atomic<long> liveNodes(0); // for checking that every version is reclaimed
+
+template<class K, class V>
+class PersistentMap
+{
+    struct Node
+    {
+        K key;
+        V val;
+        Node *left, *right;
+        uint64_t prio;
+        size_t size;
+        atomic<int> refs;
+
+        Node(const K& k, const V& v, Node* l, Node* r, uint64_t p)
+            : key(k), val(v), left(l), right(r), prio(p),
+              size(1 + (l ? l->size : 0) + (r ? r->size : 0)), refs(1)
+        {
+            liveNodes.fetch_add(1, memory_order_relaxed);
+        }
+        ~Node() { liveNodes.fetch_sub(1, memory_order_relaxed); }
+    };
+
+    public:
+        PersistentMap() : root(nullptr) {}
+        PersistentMap(const PersistentMap& o) : root(share(o.root)) {}
+        PersistentMap(PersistentMap&& o) noexcept : root(o.root) { o.root = nullptr; }
+        PersistentMap& operator=(PersistentMap o)
+        {
+            swap(root, o.root);
+            return *this;
+        }
+        ~PersistentMap() { release(root); }
+
+        size_t size() const { return root ? root->size : 0; }
+
+        const V* find(const K& k) const
+        {
+            Node* t = root;
+            while(t)
+            {
+                if(k < t->key)
+                    t = t->left;
+                else if(t->key < k)
+                    t = t->right;
+                else
+                    return &t->val;
+            }
+            return nullptr;
+        }
+
+        // New version with k -> v; this version is unchanged
+        PersistentMap insert(const K& k, const V& v) const
+        {
+            return PersistentMap(insert(root, k, v, priority(k)));
+        }
+
+        PersistentMap erase(const K& k) const
+        {
+            if(!find(k))
+                return *this;
+            return PersistentMap(erase(root, k));
+        }
+
+        // In-order walk without recursion
+        template<class F>
+        void forEach(F f) const
+        {
+            vector<Node*> st;
+            for(Node* t = root; t || !st.empty(); )
+            {
+                for(; t; t = t->left)
+                    st.push_back(t);
+                t = st.back();
+                st.pop_back();
+                f(t->key, t->val);
+                t = t->right;
+            }
+        }
+
+    private:
+        Node* root;
+        template<class, class> friend class SharedMap;
+
+        explicit PersistentMap(Node* adopted) : root(adopted) {}
+
+        static uint64_t priority(const K& k)
+        {
+            uint64_t x = hash<K>()(k) + 0x9e3779b97f4a7c15ULL;
+            x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+            return x ^ (x >> 31);
+        }
+
+        // Heap order on (prio, key) so that equal hashes still give one shape
+        static bool above(uint64_t p, const K& k, const Node* t)
+        {
+            return p != t->prio ? p > t->prio : k < t->key;
+        }
+
+        static Node* share(Node* t)
+        {
+            if(t)
+                t->refs.fetch_add(1, memory_order_relaxed);
+            return t;
+        }
+
+        static void release(Node* t)
+        {
+            vector<Node*> st;
+            if(t)
+                st.push_back(t);
+            while(!st.empty())
+            {
+                Node* u = st.back();
+                st.pop_back();
+                if(u->refs.fetch_sub(1, memory_order_acq_rel) != 1)
+                    continue;
+                if(u->left)
+                    st.push_back(u->left);
+                if(u->right)
+                    st.push_back(u->right);
+                delete u;
+            }
+        }
+
+        // The functions below only read their Node* arguments and return a node
+        // the caller owns; new nodes take ownership of the children passed in.
+        static Node* copyWith(const Node* t, Node* l, Node* r)
+        {
+            return new Node(t->key, t->val, l, r, t->prio);
+        }
+
+        // Copies the search path of k, l gets the keys < k and r the rest
+        static void split(Node* t, const K& k, Node*& l, Node*& r)
+        {
+            if(!t)
+            {
+                l = r = nullptr;
+                return;
+            }
+            Node *a, *b;
+            if(t->key < k)
+            {
+                split(t->right, k, a, b);
+                l = copyWith(t, share(t->left), a);
+                r = b;
+            }
+            else
+            {
+                split(t->left, k, a, b);
+                l = a;
+                r = copyWith(t, b, share(t->right));
+            }
+        }
+
+        static Node* merge(Node* a, Node* b)
+        {
+            if(!a || !b)
+                return share(a ? a : b);
+            if(above(a->prio, a->key, b))
+                return copyWith(a, share(a->left), merge(a->right, b));
+            return copyWith(b, merge(a, b->left), share(b->right));
+        }
+
+        static Node* insert(Node* t, const K& k, const V& v, uint64_t p)
+        {
+            if(!t)
+                return new Node(k, v, nullptr, nullptr, p);
+            if(!(k < t->key) && !(t->key < k))
+                return new Node(k, v, share(t->left), share(t->right), p);
+            if(above(p, k, t))
+            {
+                // k is not in t: its priority would be above t's
+                Node *l, *r;
+                split(t, k, l, r);
+                return new Node(k, v, l, r, p);
+            }
+            if(k < t->key)
+                return copyWith(t, insert(t->left, k, v, p), share(t->right));
+            return copyWith(t, share(t->left), insert(t->right, k, v, p));
+        }
+
+        // k must be present
+        static Node* erase(Node* t, const K& k)
+        {
+            if(k < t->key)
+                return copyWith(t, erase(t->left, k), share(t->right));
+            if(t->key < k)
+                return copyWith(t, share(t->left), erase(t->right, k));
+            return merge(t->left, t->right);
+        }
+};
+
+// One mutable "current version" shared between threads
+template<class K, class V>
+class SharedMap
+{
+    typedef PersistentMap<K, V> Map;
+    typedef typename Map::Node Node;
+
+    public:
+        static const int MAX_READERS = 64;
+
+        SharedMap() : current(nullptr)
+        {
+            for(int i = 0; i < MAX_READERS; i++)
+            {
+                hazard[i].store(nullptr);
+                busy[i].store(false);
+            }
+        }
+        ~SharedMap()
+        {
+            for(Node* r : retired)
+                Map::release(r);
+            Map::release(current.load());
+        }
+
+        // Lock-free for up to MAX_READERS concurrent callers
+        Map snapshot()
+        {
+            int slot = 0;
+            for(bool expected = false; ; slot = (slot + 1) % MAX_READERS, expected = false)
+                if(busy[slot].compare_exchange_weak(expected, true, memory_order_acquire))
+                    break;
+            Node* p;
+            do
+            {
+                p = current.load();
+                hazard[slot].store(p);
+            } while(current.load() != p);
+            Map m(Map::share(p));
+            hazard[slot].store(nullptr);
+            busy[slot].store(false, memory_order_release);
+            return m;
+        }
+
+        // Replaces the current version with f(current)
+        template<class F>
+        void update(F f)
+        {
+            lock_guard<mutex> lock(writer);
+            Map old(Map::share(current.load()));
+            Map next = f(old);
+            Node* prev = current.exchange(next.root);
+            next.root = nullptr; // ownership moved into `current`
+            if(prev)
+                retired.push_back(prev);
+            reclaim();
+        }
+
+    private:
+        atomic<Node*> current;
+        atomic<Node*> hazard[MAX_READERS];
+        atomic<bool> busy[MAX_READERS];
+        mutex writer;
+        vector<Node*> retired; // old roots, guarded by `writer`
+
+        void reclaim()
+        {
+            Node* inUse[MAX_READERS];
+            int used = 0;
+            for(int i = 0; i < MAX_READERS; i++)
+                if(Node* h = hazard[i].load())
+                    inUse[used++] = h;
+            size_t kept = 0;
+            for(Node* r : retired)
+            {
+                if(find(inUse, inUse + used, r) != inUse + used)
+                    retired[kept++] = r;
+                else
+                    Map::release(r);
+            }
+            retired.resize(kept);
+        }
+};
+
+int main()
+{
+    {
+        // Every version stays readable after later updates
+        PersistentMap<int, string> v0;
+        PersistentMap<int, string> v1 = v0.insert(50, "fifty").insert(30, "thirty").insert(70, "seventy");
+        PersistentMap<int, string> v2 = v1.erase(30).insert(60, "sixty");
+        auto print = [](const char* name, const PersistentMap<int, string>& m) {
+            printf("%s:", name);
+            m.forEach([](int k, const string& v) { printf(" %d=%s", k, v.c_str()); });
+            printf("\n");
+        };
+        print("v0", v0);
+        print("v1", v1);
+        print("v2", v2);
+    }
+
+    // One writer keeps the invariant "keys are exactly [lo, hi), value = 2 * key"
+    // while readers check it on their snapshots
+    const int steps = 200000, readers = 4;
+    {
+        SharedMap<int, int> shared;
+        atomic<bool> done(false);
+        atomic<long> snapshots(0), broken(0);
+        vector<thread> pool;
+        for(int r = 0; r < readers; r++)
+            pool.emplace_back([&]() {
+                while(!done.load())
+                {
+                    PersistentMap<int, int> s = shared.snapshot();
+                    long count = 0, first = LONG_MIN, prev = LONG_MIN;
+                    s.forEach([&](int k, int v) {
+                        if(first == LONG_MIN)
+                            first = k;
+                        if((prev != LONG_MIN && k != prev + 1) || v != 2 * k)
+                            broken++;
+                        prev = k;
+                        count++;
+                    });
+                    if((size_t)count != s.size())
+                        broken++;
+                    snapshots++;
+                }
+            });
+        auto start = chrono::steady_clock::now();
+        int lo = 0, hi = 0;
+        for(int i = 0; i < steps; i++)
+        {
+            if(hi - lo < 1000 || i % 3)
+            {
+                shared.update([&](const PersistentMap<int, int>& m) { return m.insert(hi, 2 * hi); });
+                hi++;
+            }
+            else
+            {
+                shared.update([&](const PersistentMap<int, int>& m) { return m.erase(lo); });
+                lo++;
+            }
+        }
+        double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        done = true;
+        for(auto& t : pool)
+            t.join();
+        PersistentMap<int, int> last = shared.snapshot();
+        printf("\n%d updates in %.3f s with %d readers, %ld snapshots checked, %ld broken, final size %zu\n",
+               steps, secs, readers, snapshots.load(), broken.load(), last.size());
+    }
+    printf("nodes still allocated after all versions are gone: %ld\n", liveNodes.load());
+    return 0;
+}
@@ -0,0 +1,303 @@
+// Lowest common ancestor and tree distance queries.
+//
+// distanceStartNodeLeafNode_wellsFargo.cpp and closestNodeToGiven_JPMC.cpp find
+// the distance between two nodes by searching for one from the root and walking
+// back up, O(depth) per question. LCAEngine answers lca(u,v) and dist(u,v) in O(1)
+// after O(n) preprocessing:
+//
+//  - an iterative DFS writes the Euler tour (2n-1 entries) with the depth of each
+//    entry; lca(u,v) is the shallowest entry between the first visits of u and v
+//  - the tour is split into blocks of 64 (Farach-Colton-Bender). A sparse table
+//    over the block minima has (2n/64) log(2n/64) entries, i.e. O(n) for any n
+//    that fits in memory
+//  - inside a block, mask[i] has bit j set when entry j of the block is on the
+//    min-stack after pushing i (the entries that are smaller than everything
+//    after them up to i). The minimum of [l, i] is then the lowest set bit of
+//    mask[i] at or above l, one shift and one ctz.
+//
+// TarjanLCA is the offline alternative when all the queries are known up front: one
+// DFS with a union-find, O((n + q) alpha(n)) and no tables at all.
+//
+// Usage: ./treeLCA [N] [Q]  checks both against walking parent pointers.
+#include <bits/stdc++.h>
+using namespace std;
+
+// Rooted tree in compressed adjacency form, built from an undirected edge list
+struct Tree
+{
+    int n, root;
+    vector<int> start, adj;
+
+    Tree(int n, const vector<pair<int,int>>& edges, int root = 0) : n(n), root(root), start(n+1, 0)
+    {
+        adj.resize(2 * edges.size());
+        for(auto& e : edges)
+        {
+            start[e.first+1]++;
+            start[e.second+1]++;
+        }
+        for(int i = 0; i < n; i++)
+            start[i+1] += start[i];
+        vector<int> pos(start.begin(), start.end() - 1);
+        for(auto& e : edges)
+        {
+            adj[pos[e.first]++] = e.second;
+            adj[pos[e.second]++] = e.first;
+        }
+    }
+};
+
+class LCAEngine
+{
+    public:
+        LCAEngine(const Tree& t) : n(t.n), depth(t.n), first(t.n)
+        {
+            eulerTour(t);
+            buildBlocks();
+        }
+
+        int lca(int u, int v) const
+        {
+            int l = first[u], r = first[v];
+            if(l > r)
+                swap(l, r);
+            return node[query(l, r)];
+        }
+
+        int dist(int u, int v) const
+        {
+            return depth[u] + depth[v] - 2 * depth[lca(u, v)];
+        }
+
+    private:
+        static const int B = 64;
+        int n, m = 0, blocks = 0;
+        vector<int> depth, first;
+        vector<int> node, level;      // Euler tour: node and its depth per entry
+        vector<uint64_t> mask;        // in-block min-stack per entry
+        vector<vector<int>> sparse;   // sparse[k][b] = argmin over blocks [b, b + 2^k)
+
+        void eulerTour(const Tree& t)
+        {
+            node.reserve(2 * n);
+            level.reserve(2 * n);
+            // Stack of (node, next adjacency slot); parent is the entry below it
+            vector<pair<int,int>> st;
+            vector<int> parent(n, -1);
+            st.push_back({t.root, t.start[t.root]});
+            depth[t.root] = 0;
+            first[t.root] = 0;
+            node.push_back(t.root);
+            level.push_back(0);
+            while(!st.empty())
+            {
+                int u = st.back().first;
+                int& it = st.back().second;
+                if(it < t.start[u+1])
+                {
+                    int v = t.adj[it++];
+                    if(v == parent[u])
+                        continue;
+                    parent[v] = u;
+                    depth[v] = depth[u] + 1;
+                    first[v] = (int)node.size();
+                    node.push_back(v);
+                    level.push_back(depth[v]);
+                    st.push_back({v, t.start[v]});
+                }
+                else
+                {
+                    st.pop_back();
+                    if(!st.empty())
+                    {
+                        node.push_back(st.back().first);
+                        level.push_back(depth[st.back().first]);
+                    }
+                }
+            }
+            m = (int)node.size();
+        }
+
+        int better(int i, int j) const { return level[i] <= level[j] ? i : j; }
+
+        void buildBlocks()
+        {
+            blocks = (m + B - 1) / B;
+            mask.assign(m, 0);
+            vector<int> blockMin(blocks);
+            for(int b = 0; b < blocks; b++)
+            {
+                int lo = b * B, hi = min(m, lo + B);
+                uint64_t cur = 0;
+                for(int i = lo; i < hi; i++)
+                {
+                    // Pop everything not smaller than level[i], then push i
+                    while(cur && level[lo + 63 - __builtin_clzll(cur)] >= level[i])
+                        cur ^= 1ULL << (63 - __builtin_clzll(cur));
+                    cur |= 1ULL << (i - lo);
+                    mask[i] = cur;
+                }
+                blockMin[b] = lo + __builtin_ctzll(mask[hi-1]);
+            }
+            sparse.push_back(blockMin);
+            for(int k = 1; (1 << k) <= blocks; k++)
+            {
+                const vector<int>& prev = sparse[k-1];
+                vector<int> cur(blocks - (1 << k) + 1);
+                for(size_t b = 0; b < cur.size(); b++)
+                    cur[b] = better(prev[b], prev[b + (1 << (k-1))]);
+                sparse.push_back(move(cur));
+            }
+        }
+
+        // Position of the minimum in [l, r], both inside one block
+        int inBlock(int l, int r) const
+        {
+            int lo = l / B * B;
+            return lo + __builtin_ctzll(mask[r] >> (l - lo) << (l - lo));
+        }
+
+        int query(int l, int r) const
+        {
+            int bl = l / B, br = r / B;
+            if(bl == br)
+                return inBlock(l, r);
+            int best = better(inBlock(l, bl * B + B - 1), inBlock(br * B, r));
+            if(bl + 1 < br)
+            {
+                int k = 31 - __builtin_clz(br - bl - 1);
+                best = better(best, better(sparse[k][bl+1], sparse[k][br - (1 << k)]));
+            }
+            return best;
+        }
+};
+
+// Offline LCA: a DFS where every finished subtree is unioned into its parent, so
+// find(v) is the lowest ancestor of v whose DFS is still open. When u finishes,
+// each query (u, v) with v already finished is answered by find(v).
+vector<int> tarjanLCA(const Tree& t, const vector<pair<int,int>>& queries)
+{
+    int n = t.n, q = (int)queries.size();
+    vector<int> qStart(n+1, 0), qList(2 * q);
+    for(auto& p : queries)
+    {
+        qStart[p.first+1]++;
+        qStart[p.second+1]++;
+    }
+    for(int i = 0; i < n; i++)
+        qStart[i+1] += qStart[i];
+    vector<int> pos(qStart.begin(), qStart.end() - 1);
+    for(int i = 0; i < q; i++)
+    {
+        qList[pos[queries[i].first]++] = i;
+        qList[pos[queries[i].second]++] = i;
+    }
+
+    vector<int> dsu(n), anc(n), parent(n, -1), answer(q, -1);
+    vector<char> done(n, 0);
+    iota(dsu.begin(), dsu.end(), 0);
+    auto find = [&](int x) {
+        while(dsu[x] != x)
+        {
+            dsu[x] = dsu[dsu[x]];
+            x = dsu[x];
+        }
+        return x;
+    };
+
+    vector<pair<int,int>> st;
+    st.push_back({t.root, t.start[t.root]});
+    anc[t.root] = t.root;
+    while(!st.empty())
+    {
+        int u = st.back().first;
+        int& it = st.back().second;
+        if(it < t.start[u+1])
+        {
+            int v = t.adj[it++];
+            if(v == parent[u])
+                continue;
+            parent[v] = u;
+            anc[v] = v;
+            st.push_back({v, t.start[v]});
+            continue;
+        }
+        st.pop_back();
+        done[u] = 1;
+        for(int j = qStart[u]; j < qStart[u+1]; j++)
+        {
+            int i = qList[j];
+            int other = queries[i].first == u ? queries[i].second : queries[i].first;
+            if(done[other] && answer[i] == -1)
+                answer[i] = anc[find(other)];
+        }
+        if(parent[u] != -1)
+        {
+            int a = find(u), b = find(parent[u]);
+            dsu[a] = b;
+            anc[b] = parent[u];
+        }
+    }
+    return answer;
+}
+
+template<class F>
+double timeIt(F f)
+{
+    auto start = chrono::steady_clock::now();
+    f();
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv)
+{
+    // The tree from distanceStartNodeLeafNode_wellsFargo.cpp, nodes numbered level by level
+    vector<pair<int,int>> example = {{0,1}, {0,2}, {2,3}, {2,4}, {3,5}, {3,6}, {4,7}, {4,8}};
+    Tree small(9, example);
+    LCAEngine e(small);
+    printf("lca(5, 8) = %d, dist(5, 8) = %d, dist(1, 6) = %d\n", e.lca(5, 8), e.dist(5, 8), e.dist(1, 6));
+
+    // Random tree, half of it a long path so that walking up is expensive
+    int n = argc > 1 ? atoi(argv[1]) : 1000000;
+    int q = argc > 2 ? atoi(argv[2]) : 1000000;
+    mt19937 rng(11);
+    vector<pair<int,int>> edges;
+    vector<int> parent(n, -1), depth(n, 0);
+    for(int v = 1; v < n; v++)
+    {
+        parent[v] = v < n / 2 ? v - 1 : (int)(rng() % v);
+        depth[v] = depth[parent[v]] + 1;
+        edges.push_back({parent[v], v});
+    }
+    vector<pair<int,int>> queries(q);
+    for(auto& p : queries)
+        p = {(int)(rng() % n), (int)(rng() % n)};
+    Tree t(n, edges);
+
+    LCAEngine* engine = nullptr;
+    vector<int> a(q), b, c(q);
+    double tBuild = timeIt([&]() { engine = new LCAEngine(t); });
+    double tQuery = timeIt([&]() { for(int i = 0; i < q; i++) a[i] = engine->lca(queries[i].first, queries[i].second); });
+    double tTarjan = timeIt([&]() { b = tarjanLCA(t, queries); });
+    // Baseline: lift the deeper node, then both together (capped so it stays quick)
+    int naive = min(q, 2000);
+    double tNaive = timeIt([&]() {
+        for(int i = 0; i < naive; i++)
+        {
+            int u = queries[i].first, v = queries[i].second;
+            while(depth[u] > depth[v]) u = parent[u];
+            while(depth[v] > depth[u]) v = parent[v];
+            while(u != v) { u = parent[u]; v = parent[v]; }
+            c[i] = u;
+        }
+    });
+
+    bool ok = a == b && equal(c.begin(), c.begin() + naive, a.begin());
+    printf("\n%d nodes, %d queries\n", n, q);
+    printf("Euler + block sparse table  build %.3f s, queries %.3f s\n", tBuild, tQuery);
+    printf("Tarjan offline              %.3f s\n", tTarjan);
+    printf("walking parents             %.3f s for %d queries\n", tNaive, naive);
+    printf(ok ? "results match\n" : "MISMATCH\n");
+    delete engine;
+    return 0;
+}
@@ -0,0 +1,733 @@
+// Exact minimum vertex cover for general (sparse) graphs.
+//
+// vertexCover_UndirectedGraph_JPMC.cpp only gives the 2-approximation and
+// vertexCover_recursive.cpp / vertexCoverDP_JPMC.cpp only handle binary trees.
+// This solver works in three stages:
+//
+//  1. Kernelization, repeated until nothing changes
+//       - degree 0: drop the vertex
+//       - degree 1: take its neighbour
+//       - degree 2 with adjacent neighbours (triangle): take both neighbours
+//       - degree 2 otherwise: fold v, a, b into one new vertex w. Any cover of the
+//         folded graph extends with +1: w in cover -> {a, b}, otherwise -> {v}
+//       - crown / LP reduction (Nemhauser-Trotter): the half-integral LP optimum
+//         is read off a maximum matching of the bipartite double cover (Hopcroft-Karp
+//         + Konig). Vertices at 1 are taken, vertices at 0 dropped. Every crown is
+//         removed by this rule.
+//  2. The kernel is split into connected components which are solved independently.
+//  3. Branch and bound per component: branch on a maximum degree vertex v (take v,
+//     or take all of N(v)). Every node applies the degree 0/1 rules and the LP
+//     reduction, and prunes with the LP lower bound (half the size of a maximum
+//     matching of the double cover, warm started from the parent's matching).
+//     Graphs of maximum degree 2 (disjoint cycles) are solved directly. A greedy
+//     cover gives the first upper bound, then the top levels of the search tree
+//     are expanded into independent subproblems which worker threads pick up,
+//     sharing the best bound found so far.
+//
+// Input: "V E" followed by E lines "u v" (0-indexed).
+// Output: the size of a minimum vertex cover and its vertices.
+// Compile with -O2 -pthread.
+#include <bits/stdc++.h>
+using namespace std;
+
+// Hopcroft-Karp on an explicit bipartite adjacency, iterative DFS
+struct BipartiteMatcher
+{
+    int L, R;
+    const vector<vector<int>>& adj;
+    vector<int> matchL, matchR, dist, it;
+
+    BipartiteMatcher(int L, int R, const vector<vector<int>>& adj)
+        : L(L), R(R), adj(adj), matchL(L, -1), matchR(R, -1), dist(L), it(L) {}
+
+    bool bfs()
+    {
+        vector<int> queue;
+        for(int u = 0; u < L; u++)
+        {
+            dist[u] = (matchL[u] == -1) ? 0 : INT_MAX;
+            if(dist[u] == 0)
+                queue.push_back(u);
+        }
+        bool found = false;
+        for(size_t head = 0; head < queue.size(); head++)
+        {
+            int u = queue[head];
+            for(int v : adj[u])
+            {
+                int w = matchR[v];
+                if(w == -1)
+                    found = true;
+                else if(dist[w] == INT_MAX)
+                {
+                    dist[w] = dist[u] + 1;
+                    queue.push_back(w);
+                }
+            }
+        }
+        return found;
+    }
+
+    bool augment(int root, vector<int>& stack)
+    {
+        stack.assign(1, root);
+        while(!stack.empty())
+        {
+            int u = stack.back();
+            if(it[u] == (int)adj[u].size())
+            {
+                dist[u] = INT_MAX;
+                stack.pop_back();
+                if(!stack.empty())
+                    it[stack.back()]++;
+                continue;
+            }
+            int w = matchR[adj[u][it[u]]];
+            if(w == -1)
+            {
+                for(int x : stack)
+                {
+                    int y = adj[x][it[x]];
+                    matchL[x] = y;
+                    matchR[y] = x;
+                }
+                return true;
+            }
+            if(dist[w] == dist[u] + 1)
+                stack.push_back(w);
+            else
+                it[u]++;
+        }
+        return false;
+    }
+
+    void solve()
+    {
+        vector<int> stack;
+        while(bfs())
+        {
+            fill(it.begin(), it.end(), 0);
+            for(int u = 0; u < L; u++)
+                if(matchL[u] == -1)
+                    augment(u, stack);
+        }
+    }
+};
+
+class Kernelizer
+{
+    public:
+        vector<vector<int>> adj; // sorted neighbour lists, grows with every fold
+        vector<char> gone, inCover;
+
+        Kernelizer(int V, const vector<pair<int,int>>& edges) : adj(V), gone(V, 0), inCover(V, 0)
+        {
+            for(auto& e : edges)
+                if(e.first != e.second)
+                {
+                    adj[e.first].push_back(e.second);
+                    adj[e.second].push_back(e.first);
+                }
+            for(auto& a : adj)
+            {
+                sort(a.begin(), a.end());
+                a.erase(unique(a.begin(), a.end()), a.end());
+            }
+        }
+
+        void run()
+        {
+            for(int v = 0; v < (int)adj.size(); v++)
+                work.push_back(v);
+            do
+            {
+                while(!work.empty())
+                {
+                    int v = work.back();
+                    work.pop_back();
+                    if(!gone[v])
+                        degreeRules(v);
+                }
+            } while(lpReduce());
+        }
+
+        // Turns a cover of the kernel (marked in inCover) into a cover of the input
+        void unfold()
+        {
+            for(int i = (int)folds.size()-1; i >= 0; i--)
+            {
+                Fold& f = folds[i];
+                if(inCover[f.w])
+                    inCover[f.a] = inCover[f.b] = 1;
+                else
+                    inCover[f.v] = 1;
+            }
+        }
+
+    private:
+        struct Fold { int v, a, b, w; };
+        vector<Fold> folds;
+        vector<int> work;
+
+        static void eraseSorted(vector<int>& a, int x)
+        {
+            auto it = lower_bound(a.begin(), a.end(), x);
+            if(it != a.end() && *it == x)
+                a.erase(it);
+        }
+
+        static void insertSorted(vector<int>& a, int x)
+        {
+            auto it = lower_bound(a.begin(), a.end(), x);
+            if(it == a.end() || *it != x)
+                a.insert(it, x);
+        }
+
+        void removeVertex(int v)
+        {
+            for(int u : adj[v])
+            {
+                eraseSorted(adj[u], v);
+                work.push_back(u);
+            }
+            vector<int>().swap(adj[v]);
+            gone[v] = 1;
+        }
+
+        void take(int v)
+        {
+            inCover[v] = 1;
+            removeVertex(v);
+        }
+
+        void degreeRules(int v)
+        {
+            if(adj[v].empty())
+                gone[v] = 1;
+            else if(adj[v].size() == 1)
+            {
+                take(adj[v][0]);
+                gone[v] = 1;
+            }
+            else if(adj[v].size() == 2)
+            {
+                int a = adj[v][0], b = adj[v][1];
+                if(binary_search(adj[a].begin(), adj[a].end(), b))
+                {
+                    take(a);
+                    take(b);
+                    gone[v] = 1;
+                    return;
+                }
+                int w = (int)adj.size();
+                vector<int> merged;
+                set_union(adj[a].begin(), adj[a].end(), adj[b].begin(), adj[b].end(), back_inserter(merged));
+                eraseSorted(merged, v);
+                removeVertex(v);
+                for(int x : {a, b})
+                {
+                    for(int u : adj[x])
+                        eraseSorted(adj[u], x);
+                    vector<int>().swap(adj[x]);
+                    gone[x] = 1;
+                }
+                for(int u : merged)
+                {
+                    insertSorted(adj[u], w);
+                    work.push_back(u);
+                }
+                adj.push_back(merged);
+                gone.push_back(0);
+                inCover.push_back(0);
+                folds.push_back({v, a, b, w});
+                work.push_back(w);
+            }
+        }
+
+        bool lpReduce()
+        {
+            vector<int> verts, local(adj.size(), -1);
+            for(int v = 0; v < (int)adj.size(); v++)
+                if(!gone[v])
+                {
+                    local[v] = (int)verts.size();
+                    verts.push_back(v);
+                }
+            int n = (int)verts.size();
+            if(n == 0)
+                return false;
+            vector<vector<int>> bip(n);
+            for(int i = 0; i < n; i++)
+                for(int u : adj[verts[i]])
+                    bip[i].push_back(local[u]);
+            BipartiteMatcher hk(n, n, bip);
+            hk.solve();
+
+            // Konig: Z = vertices reachable from free left vertices by alternating paths
+            vector<char> zL(n, 0), zR(n, 0);
+            vector<int> queue;
+            for(int i = 0; i < n; i++)
+                if(hk.matchL[i] == -1)
+                    zL[i] = 1, queue.push_back(i);
+            for(size_t head = 0; head < queue.size(); head++)
+                for(int r : bip[queue[head]])
+                    if(!zR[r])
+                    {
+                        zR[r] = 1;
+                        int l = hk.matchR[r];
+                        if(l != -1 && !zL[l])
+                            zL[l] = 1, queue.push_back(l);
+                    }
+            // x_v = ([v_L in cover] + [v_R in cover]) / 2 with cover = (L \ Z) + (R & Z)
+            vector<int> ones, zeros;
+            for(int i = 0; i < n; i++)
+            {
+                int x = (!zL[i]) + zR[i];
+                if(x == 2)
+                    ones.push_back(verts[i]);
+                else if(x == 0)
+                    zeros.push_back(verts[i]);
+            }
+            for(int v : ones)
+                take(v);
+            for(int v : zeros)
+                if(!gone[v])
+                    removeVertex(v);
+            return !ones.empty() || !zeros.empty();
+        }
+};
+
+// Branch and bound on one connected component given in CSR form
+class ComponentSolver
+{
+    public:
+        ComponentSolver(const vector<int>& offset, const vector<int>& nbr, int threads)
+            : offset(offset), nbr(nbr), n((int)offset.size() - 1), threads(threads),
+              bestSize(n) // taking every vertex is always a cover
+        {
+            best.resize(n);
+            iota(best.begin(), best.end(), 0);
+        }
+
+        vector<int> solve()
+        {
+            {
+                State s(*this);
+                while(s.reduce(), s.edges > 0)
+                    s.take(maxDegreeVertex(s));
+                record(s.cover);
+            }
+            // Expand the top of the search tree into independent subproblems
+            int splitDepth = threads > 1 ? 2 + (int)ceil(log2(threads)) : 0;
+            vector<vector<int>> tasks;
+            {
+                State s(*this);
+                search(s, 0, splitDepth, &tasks);
+            }
+            atomic<size_t> next(0);
+            auto worker = [&]() {
+                State s(*this);
+                for(size_t k; (k = next.fetch_add(1)) < tasks.size(); )
+                {
+                    s.reset();
+                    for(int v : tasks[k])
+                        s.take(v);
+                    search(s, 0, 0, nullptr);
+                }
+            };
+            vector<thread> pool;
+            for(int t = 1; t < threads && t < (int)tasks.size(); t++)
+                pool.emplace_back(worker);
+            worker();
+            for(auto& th : pool)
+                th.join();
+            return best;
+        }
+
+    private:
+        const vector<int>& offset;
+        const vector<int>& nbr;
+        int n, threads;
+        atomic<int> bestSize;
+        vector<int> best;
+        mutex bestLock;
+
+        struct State
+        {
+            const ComponentSolver& g;
+            vector<char> alive;
+            vector<int> deg, trail, cover, pending;
+            long long edges;
+
+            State(const ComponentSolver& g) : g(g) { reset(); }
+
+            void reset()
+            {
+                alive.assign(g.n, 1);
+                deg.resize(g.n);
+                edges = 0;
+                for(int v = 0; v < g.n; v++)
+                {
+                    deg[v] = g.offset[v+1] - g.offset[v];
+                    edges += deg[v];
+                }
+                edges /= 2;
+                trail.clear();
+                cover.clear();
+                pending.clear();
+            }
+
+            void remove(int v)
+            {
+                alive[v] = 0;
+                for(int k = g.offset[v]; k < g.offset[v+1]; k++)
+                {
+                    int u = g.nbr[k];
+                    if(alive[u])
+                    {
+                        edges--;
+                        if(--deg[u] <= 1)
+                            pending.push_back(u);
+                    }
+                }
+                trail.push_back(v);
+            }
+
+            void take(int v)
+            {
+                cover.push_back(v);
+                remove(v);
+            }
+
+            void undo(size_t trailSize, size_t coverSize)
+            {
+                while(trail.size() > trailSize)
+                {
+                    int v = trail.back();
+                    trail.pop_back();
+                    for(int k = g.offset[v]; k < g.offset[v+1]; k++)
+                        if(alive[g.nbr[k]])
+                            edges++, deg[g.nbr[k]]++;
+                    alive[v] = 1;
+                }
+                cover.resize(coverSize);
+                pending.clear();
+            }
+
+            // Degree 0 and degree 1 rules for everything queued in `pending`
+            void reduce()
+            {
+                while(!pending.empty())
+                {
+                    int v = pending.back();
+                    pending.pop_back();
+                    if(!alive[v] || deg[v] > 1)
+                        continue;
+                    if(deg[v] == 1)
+                        for(int k = g.offset[v]; k < g.offset[v+1]; k++)
+                            if(alive[g.nbr[k]])
+                            {
+                                take(g.nbr[k]);
+                                break;
+                            }
+                    remove(v);
+                }
+            }
+
+            // Maximum matching of the bipartite double cover of the alive graph. Its size
+            // is twice the LP optimum, so cover + ceil(size/2) is a lower bound. The
+            // matching is kept between calls: pairs touching dead vertices are dropped
+            // and the rest stays valid both deeper in the tree and after backtracking.
+            vector<int> mL, mR, dist, it, queue, stack;
+
+            int doubleCoverMatching()
+            {
+                if(mL.empty())
+                {
+                    mL.assign(g.n, -1);
+                    mR.assign(g.n, -1);
+                    dist.resize(g.n);
+                    it.resize(g.n);
+                }
+                int size = 0;
+                for(int u = 0; u < g.n; u++)
+                    if(mL[u] != -1)
+                    {
+                        if(!alive[u] || !alive[mL[u]])
+                            mR[mL[u]] = -1, mL[u] = -1;
+                        else
+                            size++;
+                    }
+                while(true)
+                {
+                    queue.clear();
+                    for(int u = 0; u < g.n; u++)
+                    {
+                        dist[u] = (alive[u] && mL[u] == -1) ? 0 : INT_MAX;
+                        if(dist[u] == 0)
+                            queue.push_back(u);
+                    }
+                    bool found = false;
+                    for(size_t head = 0; head < queue.size(); head++)
+                    {
+                        int u = queue[head];
+                        for(int k = g.offset[u]; k < g.offset[u+1]; k++)
+                        {
+                            int v = g.nbr[k];
+                            if(!alive[v])
+                                continue;
+                            if(mR[v] == -1)
+                                found = true;
+                            else if(dist[mR[v]] == INT_MAX)
+                            {
+                                dist[mR[v]] = dist[u] + 1;
+                                queue.push_back(mR[v]);
+                            }
+                        }
+                    }
+                    if(!found)
+                        return size;
+                    for(int u = 0; u < g.n; u++)
+                        it[u] = g.offset[u];
+                    for(int root = 0; root < g.n; root++)
+                        if(alive[root] && mL[root] == -1 && augment(root))
+                            size++;
+                }
+            }
+
+            bool augment(int root)
+            {
+                stack.assign(1, root);
+                while(!stack.empty())
+                {
+                    int u = stack.back();
+                    if(it[u] == g.offset[u+1])
+                    {
+                        dist[u] = INT_MAX;
+                        stack.pop_back();
+                        if(!stack.empty())
+                            it[stack.back()]++;
+                        continue;
+                    }
+                    int v = g.nbr[it[u]];
+                    if(!alive[v])
+                    {
+                        it[u]++;
+                        continue;
+                    }
+                    if(mR[v] == -1)
+                    {
+                        for(int x : stack)
+                        {
+                            int y = g.nbr[it[x]];
+                            mL[x] = y;
+                            mR[y] = x;
+                        }
+                        return true;
+                    }
+                    if(dist[mR[v]] == dist[u] + 1)
+                        stack.push_back(mR[v]);
+                    else
+                        it[u]++;
+                }
+                return false;
+            }
+
+            // LP (Nemhauser-Trotter) reduction from the current matching via Konig's
+            // theorem: vertices at 1 are taken, vertices at 0 are removed.
+            bool lpReduce()
+            {
+                vector<char> zL(g.n, 0), zR(g.n, 0);
+                queue.clear();
+                for(int u = 0; u < g.n; u++)
+                    if(alive[u] && mL[u] == -1)
+                        zL[u] = 1, queue.push_back(u);
+                for(size_t head = 0; head < queue.size(); head++)
+                {
+                    int u = queue[head];
+                    for(int k = g.offset[u]; k < g.offset[u+1]; k++)
+                    {
+                        int v = g.nbr[k];
+                        if(alive[v] && !zR[v])
+                        {
+                            zR[v] = 1;
+                            if(mR[v] != -1 && !zL[mR[v]])
+                                zL[mR[v]] = 1, queue.push_back(mR[v]);
+                        }
+                    }
+                }
+                vector<int> zeros;
+                bool changed = false;
+                for(int v = 0; v < g.n; v++)
+                {
+                    if(!alive[v])
+                        continue;
+                    int x = (!zL[v]) + zR[v];
+                    if(x == 2)
+                        take(v), changed = true;
+                    else if(x == 0)
+                        zeros.push_back(v);
+                }
+                for(int v : zeros)
+                    if(alive[v])
+                        remove(v), changed = true;
+                return changed;
+            }
+        };
+
+        void record(const vector<int>& cover)
+        {
+            lock_guard<mutex> guard(bestLock);
+            if((int)cover.size() < bestSize.load())
+            {
+                best = cover;
+                bestSize.store((int)cover.size());
+            }
+        }
+
+        // Every alive vertex has degree exactly 2: a union of cycles, take every other vertex
+        void coverCycles(State& s)
+        {
+            vector<int> cover = s.cover;
+            vector<char> seen(n, 0);
+            for(int v = 0; v < n; v++)
+            {
+                if(!s.alive[v] || seen[v])
+                    continue;
+                int prev = -1, cur = v, idx = 0;
+                while(!seen[cur])
+                {
+                    seen[cur] = 1;
+                    if(idx++ % 2 == 0)
+                        cover.push_back(cur);
+                    int next = -1;
+                    for(int k = offset[cur]; k < offset[cur+1]; k++)
+                    {
+                        int u = nbr[k];
+                        if(s.alive[u] && u != prev && !seen[u])
+                        {
+                            next = u;
+                            break;
+                        }
+                    }
+                    if(next == -1)
+                        break;
+                    prev = cur;
+                    cur = next;
+                }
+            }
+            record(cover);
+        }
+
+        int maxDegreeVertex(const State& s) const
+        {
+            int v = -1;
+            for(int u = 0; u < n; u++)
+                if(s.alive[u] && (v == -1 || s.deg[u] > s.deg[v]))
+                    v = u;
+            return v;
+        }
+
+        void search(State& s, int depth, int splitDepth, vector<vector<int>>* tasks)
+        {
+            while(true)
+            {
+                s.reduce();
+                if((int)s.cover.size() >= bestSize.load())
+                    return;
+                if(s.edges == 0)
+                {
+                    record(s.cover);
+                    return;
+                }
+                int lp = (s.doubleCoverMatching() + 1) / 2;
+                if((int)s.cover.size() + lp >= bestSize.load())
+                    return;
+                if(!s.lpReduce())
+                    break;
+            }
+            if(tasks && depth >= splitDepth)
+            {
+                tasks->push_back(s.cover);
+                return;
+            }
+            int v = maxDegreeVertex(s);
+            if(s.deg[v] <= 2)
+            {
+                coverCycles(s);
+                return;
+            }
+
+            size_t trailSize = s.trail.size(), coverSize = s.cover.size();
+            s.take(v);
+            search(s, depth+1, splitDepth, tasks);
+            s.undo(trailSize, coverSize);
+
+            for(int k = offset[v]; k < offset[v+1]; k++)
+                if(s.alive[nbr[k]])
+                    s.take(nbr[k]);
+            search(s, depth+1, splitDepth, tasks);
+            s.undo(trailSize, coverSize);
+        }
+};
+
+vector<int> minimumVertexCover(int V, const vector<pair<int,int>>& edges, int threads)
+{
+    Kernelizer kernel(V, edges);
+    kernel.run();
+
+    // Connected components of the kernel, each relabelled into its own CSR
+    int total = (int)kernel.adj.size();
+    vector<int> comp(total, -1), local(total);
+    vector<vector<int>> members;
+    for(int s = 0; s < total; s++)
+    {
+        if(kernel.gone[s] || comp[s] != -1)
+            continue;
+        vector<int> list(1, s);
+        comp[s] = (int)members.size();
+        for(size_t head = 0; head < list.size(); head++)
+            for(int u : kernel.adj[list[head]])
+                if(comp[u] == -1)
+                    comp[u] = comp[s], list.push_back(u);
+        members.push_back(list);
+    }
+    // Only components big enough to be worth splitting get the worker threads
+    for(auto& list : members)
+    {
+        vector<int> offset(1, 0), nbr;
+        for(int i = 0; i < (int)list.size(); i++)
+            local[list[i]] = i;
+        for(int v : list)
+        {
+            for(int u : kernel.adj[v])
+                nbr.push_back(local[u]);
+            offset.push_back((int)nbr.size());
+        }
+        ComponentSolver solver(offset, nbr, list.size() > 64 ? threads : 1);
+        for(int v : solver.solve())
+            kernel.inCover[list[v]] = 1;
+    }
+    kernel.unfold();
+
+    vector<int> cover;
+    for(int v = 0; v < V; v++)
+        if(kernel.inCover[v])
+            cover.push_back(v);
+    return cover;
+}
+
+int main()
+{
+    int V, E;
+    if(scanf("%d %d", &V, &E) != 2)
+        return 0;
+    vector<pair<int,int>> edges(E);
+    for(auto& e : edges)
+        scanf("%d %d", &e.first, &e.second);
+    vector<int> cover = minimumVertexCover(V, edges, max(1u, thread::hardware_concurrency()));
+    printf("%d\n", (int)cover.size());
+    for(size_t i = 0; i < cover.size(); i++)
+        printf("%d%c", cover[i], i+1 == cover.size() ? '\n' : ' ');
+    return 0;
+}
@@ -4,8 +4,9 @@ public:
 		vector<int> m(256, -1);
 		int i = 0, res = 0;
 	    for (int j = 0; j < s.length(); j++) {
-			 i = max(i, m[s[j]] + 1);
-			 m[s[j]] = j;
+			 unsigned char c = s[j]; // plain char is signed: bytes >= 128 would index m[-128..-1]
+			 i = max(i, m[c] + 1);
+			 m[c] = j;
 	         res = max(res, j - i + 1);
 	    }
 		return res;
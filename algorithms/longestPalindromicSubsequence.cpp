@@ -0,0 +1,268 @@
+// Longest palindromic subsequence without the n x n table.
+//
+// interviewbit/longestPalindromicSubsequence.cpp fills int L[n][n] (a stack VLA)
+// by increasing chain length cl. Cell (i, j = i + cl - 1) only reads
+// L[i+1][j-1] from diagonal cl-2 and L[i][j-1], L[i+1][j] from diagonal cl-1,
+// and the cells of one diagonal do not depend on each other. So:
+//
+//  - lpsDiagonals keeps the two previous diagonals plus the one being written
+//    (O(n) memory) and computes a diagonal branch-free, 8 cells per step with
+//    AVX2 (4 with SSE2). Long diagonals are split between threads, which meet
+//    at a barrier after each diagonal; once diagonals get shorter than a few
+//    thousand cells per thread the barrier would cost more than the work and
+//    one thread finishes alone.
+//  - lpsBitParallel uses LPS(s) = LCS(s, reverse(s)) and the bit-parallel LCS
+//    row from bitParallelLCS.cpp, 64 cells per word operation. This is the one
+//    to use for 10^5 characters and more.
+//
+// Usage: ./longestPalindromicSubsequence [N]  (default 10^5)
+#include <bits/stdc++.h>
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+using namespace std;
+
+class LPSDiagonals
+{
+    public:
+        LPSDiagonals(string_view s, int threads = 0) : s(s), n((int)s.size())
+        {
+            if(threads <= 0)
+                threads = max(1u, thread::hardware_concurrency());
+            // Each thread should get at least minChunk cells of the longest diagonal
+            this->threads = max(1, min(threads, n / minChunk));
+        }
+
+        int solve()
+        {
+            if(n <= 1)
+                return n;
+            // d[0]: diagonal cl-2, d[1]: cl-1, d[2]: cl. Slot i is cell (i, i + cl - 1).
+            // Before cl = 2, "cl = 0" is all zeros and cl = 1 all ones.
+            for(auto& v : d)
+                v.assign(n + 8, 0);
+            fill(d[1].begin(), d[1].begin() + n, 1);
+            int cl = 2;
+            if(threads > 1)
+            {
+                vector<thread> pool;
+                for(int t = 1; t < threads; t++)
+                    pool.emplace_back([this, t]() { parallelPhase(t); });
+                cl = parallelPhase(0);
+                for(auto& th : pool)
+                    th.join();
+            }
+            for(; cl <= n; cl++)
+            {
+                diagonal(cl, 0, n - cl + 1);
+                rotate(d, d + 1, d + 3);
+            }
+            return d[1][0];
+        }
+
+    private:
+        static const int minChunk = 4096;
+        string_view s;
+        int n, threads;
+        vector<int> d[3];
+        atomic<int> arrived{0}, generation{0};
+
+        // Diagonals long enough to share; returns the first one left for thread 0
+        int parallelPhase(int t)
+        {
+            int cl = 2;
+            for(; n - cl + 1 >= threads * minChunk; cl++)
+            {
+                long long len = n - cl + 1;
+                diagonal(cl, (int)(len * t / threads), (int)(len * (t + 1) / threads));
+                barrier(t == 0);
+            }
+            return cl;
+        }
+
+        // Thread 0 waits for the others, moves the diagonals along and releases them
+        void barrier(bool leader)
+        {
+            int gen = generation.load(memory_order_acquire);
+            if(!leader)
+            {
+                arrived.fetch_add(1, memory_order_acq_rel);
+                while(generation.load(memory_order_acquire) == gen)
+                    this_thread::yield();
+                return;
+            }
+            while(arrived.load(memory_order_acquire) != threads - 1)
+                this_thread::yield();
+            rotate(d, d + 1, d + 3);
+            arrived.store(0, memory_order_relaxed);
+            generation.store(gen + 1, memory_order_release);
+        }
+
+        // Cells i in [from, to) of diagonal cl:
+        //   L = s[i] == s[j] ? d2[i+1] + 2 : max(d1[i], d1[i+1])
+        // (for cl = 2, d2 is all zeros, which gives the "== 2" case of the table)
+        void diagonal(int cl, int from, int to)
+        {
+            const int* d2 = d[0].data();
+            const int* d1 = d[1].data();
+            int* out = d[2].data();
+            const char* a = s.data();
+            const char* b = s.data() + cl - 1;
+            int i = from;
+#if defined(__AVX2__)
+            const __m256i two = _mm256_set1_epi32(2);
+            for(; i + 8 <= to; i += 8)
+            {
+                __m128i x = _mm_loadl_epi64((const __m128i*)(a + i));
+                __m128i y = _mm_loadl_epi64((const __m128i*)(b + i));
+                __m256i eq = _mm256_cvtepi8_epi32(_mm_cmpeq_epi8(x, y));
+                __m256i same = _mm256_add_epi32(_mm256_loadu_si256((const __m256i*)(d2 + i + 1)), two);
+                __m256i diff = _mm256_max_epi32(_mm256_loadu_si256((const __m256i*)(d1 + i)),
+                                                _mm256_loadu_si256((const __m256i*)(d1 + i + 1)));
+                _mm256_storeu_si256((__m256i*)(out + i), _mm256_blendv_epi8(diff, same, eq));
+            }
+#elif defined(__SSE2__)
+            // No 32-bit max or blend in SSE2: both become compare + and/andnot
+            const __m128i two = _mm_set1_epi32(2);
+            for(; i + 4 <= to; i += 4)
+            {
+                int x, y;
+                memcpy(&x, a + i, 4);
+                memcpy(&y, b + i, 4);
+                __m128i eq = _mm_cmpeq_epi8(_mm_cvtsi32_si128(x), _mm_cvtsi32_si128(y));
+                eq = _mm_unpacklo_epi16(_mm_unpacklo_epi8(eq, eq), _mm_unpacklo_epi8(eq, eq));
+                __m128i same = _mm_add_epi32(_mm_loadu_si128((const __m128i*)(d2 + i + 1)), two);
+                __m128i p = _mm_loadu_si128((const __m128i*)(d1 + i));
+                __m128i q = _mm_loadu_si128((const __m128i*)(d1 + i + 1));
+                __m128i gt = _mm_cmpgt_epi32(p, q);
+                __m128i diff = _mm_or_si128(_mm_and_si128(gt, p), _mm_andnot_si128(gt, q));
+                _mm_storeu_si128((__m128i*)(out + i), _mm_or_si128(_mm_and_si128(eq, same), _mm_andnot_si128(eq, diff)));
+            }
+#endif
+            for(; i < to; i++)
+            {
+                int same = d2[i + 1] + 2, diff = max(d1[i], d1[i + 1]);
+                out[i] = diff + ((same - diff) & -(int)(a[i] == b[i]));
+            }
+        }
+};
+
+int lpsDiagonals(string_view s, int threads = 0)
+{
+    return LPSDiagonals(s, threads).solve();
+}
+
+// LCS(s, reverse(s)) with the Allison-Dix / Hyyro row: bit j of V is 0 where the
+// row steps up, one word operation per 64 columns (see bitParallelLCS.cpp)
+int lpsBitParallel(string_view s)
+{
+    const size_t n = s.size(), words = (n + 63) / 64;
+    if(n == 0)
+        return 0;
+    string r(s.rbegin(), s.rend());
+    array<int, 256> id;
+    id.fill(-1);
+    int sigma = 0;
+    for(unsigned char c : s)
+        if(id[c] < 0)
+            id[c] = sigma++;
+    vector<uint64_t> match((size_t)sigma * words, 0);
+    for(size_t j = 0; j < n; j++)
+        match[id[(unsigned char)r[j]] * words + j / 64] |= 1ULL << (j % 64);
+
+    const uint64_t tail = n % 64 ? (1ULL << (n % 64)) - 1 : ~0ULL;
+    vector<uint64_t> v(words, ~0ULL);
+    v[words - 1] = tail;
+    for(unsigned char c : s)
+    {
+        const uint64_t* m = match.data() + id[c] * words;
+        uint64_t carry = 0;
+        for(size_t w = 0; w < words; w++)
+        {
+            uint64_t x = v[w];
+            unsigned long long sum;
+            uint64_t c1 = __builtin_uaddll_overflow(x, x & m[w], &sum);
+            uint64_t c2 = __builtin_uaddll_overflow(sum, carry, &sum);
+            carry = c1 | c2;
+            v[w] = sum | (x & ~m[w]);
+        }
+        v[words - 1] &= tail;
+    }
+    long long ones = 0;
+    for(uint64_t w : v)
+        ones += __builtin_popcountll(w);
+    return (int)(n - ones);
+}
+
+// Solution::solve from interviewbit/longestPalindromicSubsequence.cpp, table on the heap
+int lpsTable(const string& A)
+{
+    int n = A.length();
+    if(n == 0)
+        return 0;
+    vector<int> L((size_t)n * n);
+    auto at = [&](int i, int j) -> int& { return L[(size_t)i * n + j]; };
+    for(int i = 0; i < n; i++)
+        at(i, i) = 1;
+    for(int cl = 2; cl <= n; cl++)
+        for(int i = 0; i < n - cl + 1; i++)
+        {
+            int j = i + cl - 1;
+            if(A[i] == A[j] && cl == 2)
+                at(i, j) = 2;
+            else if(A[i] == A[j])
+                at(i, j) = at(i + 1, j - 1) + 2;
+            else
+                at(i, j) = max(at(i, j - 1), at(i + 1, j));
+        }
+    return at(0, n - 1);
+}
+
+template<class F>
+double timeIt(F f)
+{
+    auto start = chrono::steady_clock::now();
+    f();
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv)
+{
+    cout << "LPS(\"bebeeed\") = " << lpsDiagonals("bebeeed") << " / " << lpsBitParallel("bebeeed") << endl;
+
+    mt19937 rng(48);
+    auto randomString = [&](int len, int sigma) {
+        string s(len, ' ');
+        for(auto& c : s)
+            c = 'a' + rng() % sigma;
+        return s;
+    };
+    bool ok = true;
+    for(int it = 0; it < 300; it++)
+    {
+        string s = randomString(rng() % 150, 1 + rng() % 4);
+        int expected = lpsTable(s);
+        ok &= lpsDiagonals(s, 1) == expected && lpsBitParallel(s) == expected;
+    }
+    // Large enough that several threads share the diagonals
+    string mid = randomString(40000, 4);
+    int tThreads = 0, tOne = 0;
+    double secThreads = timeIt([&]() { tThreads = lpsDiagonals(mid); });
+    double secOne = timeIt([&]() { tOne = lpsDiagonals(mid, 1); });
+    string small = mid.substr(0, 8000);
+    int table = 0;
+    double secTable = timeIt([&]() { table = lpsTable(small); });
+    int diag = lpsDiagonals(small, 1);
+    ok &= table == diag && tThreads == tOne && tOne == lpsBitParallel(mid);
+    cout << "\n8000 characters: n x n table " << secTable << " s" << endl;
+    cout << "40000 characters: diagonals " << secOne << " s (1 thread), " << secThreads << " s ("
+         << thread::hardware_concurrency() << " threads)" << endl;
+
+    int n = argc > 1 ? atoi(argv[1]) : 100000;
+    string big = randomString(n, 4);
+    int lps = 0;
+    double secBits = timeIt([&]() { lps = lpsBitParallel(big); });
+    cout << n << " characters: bit-parallel " << secBits << " s, LPS = " << lps << endl;
+    cout << (ok ? "results match" : "MISMATCH") << endl;
+    return 0;
+}
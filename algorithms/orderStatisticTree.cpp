@@ -0,0 +1,259 @@
+// Order statistics and range sums over a changing multiset.
+//
+// meanMedianMode_microsoft.cpp finds the median with nth_element on the whole
+// array, O(n) per query, and std::set (stl/sets.cpp) cannot tell the k-th element
+// or the rank of a value. OrderStatisticTree is a treap where every node also
+// keeps the size and the sum of its subtree, so
+//
+//    insert, erase (one copy), kth, rank, sumLess, rangeSum   are O(log n) expected
+//
+// and medians/percentiles are kth queries. Nodes live in one vector used as a
+// pool and are linked by 32-bit indices (slot 0 is the empty tree, size 0 and sum
+// 0, so the updates need no null checks); erased slots go on a free list and are
+// reused, so a rolling window allocates nothing once it is full.
+//
+// Usage: ./orderStatisticTree [N] [W]  rolling median of a window of W over N
+// values, compared with copying the window and calling nth_element.
+#include <bits/stdc++.h>
+using namespace std;
+
+typedef long long ll;
+
+class OrderStatisticTree
+{
+    public:
+        OrderStatisticTree() : pool(1) {}
+
+        int size() const { return pool[root].size; }
+
+        void insert(int x)
+        {
+            int a, b;
+            split(root, x, false, a, b);
+            root = merge(merge(a, newNode(x)), b);
+        }
+
+        // Removes one copy of x, false if x is not present
+        bool erase(int x)
+        {
+            int a, rest, mid, c;
+            split(root, x, false, a, rest);
+            split(rest, x, true, mid, c);
+            bool found = mid != 0;
+            if(found)
+            {
+                int dead = mid;
+                mid = merge(pool[mid].left, pool[mid].right);
+                freeList.push_back(dead);
+            }
+            root = merge(merge(a, mid), c);
+            return found;
+        }
+
+        // k-th smallest, 0-based; k < size()
+        int kth(int k) const
+        {
+            int t = root;
+            while(true)
+            {
+                int l = pool[t].left;
+                if(k < pool[l].size)
+                    t = l;
+                else if(k == pool[l].size)
+                    return pool[t].key;
+                else
+                {
+                    k -= pool[l].size + 1;
+                    t = pool[t].right;
+                }
+            }
+        }
+
+        // Number of elements < x
+        int rank(int x) const
+        {
+            int t = root, r = 0;
+            while(t)
+            {
+                if(pool[t].key < x)
+                {
+                    r += pool[pool[t].left].size + 1;
+                    t = pool[t].right;
+                }
+                else
+                    t = pool[t].left;
+            }
+            return r;
+        }
+
+        // Sum of the elements < x
+        ll sumLess(int x) const
+        {
+            int t = root;
+            ll s = 0;
+            while(t)
+            {
+                if(pool[t].key < x)
+                {
+                    s += pool[pool[t].left].sum + pool[t].key;
+                    t = pool[t].right;
+                }
+                else
+                    t = pool[t].left;
+            }
+            return s;
+        }
+
+        // Sum of the elements in [lo, hi]
+        ll rangeSum(int lo, int hi) const
+        {
+            if(lo > hi)
+                return 0;
+            ll upto = hi == INT_MAX ? pool[root].sum : sumLess(hi + 1);
+            return upto - sumLess(lo);
+        }
+
+        double median() const
+        {
+            int n = size();
+            return n % 2 ? kth(n / 2) : ((double)kth(n / 2 - 1) + kth(n / 2)) / 2;
+        }
+
+        // Nearest-rank percentile, p in (0, 100]
+        int percentile(double p) const
+        {
+            int k = (int)ceil(p / 100 * size()) - 1;
+            return kth(max(0, min(k, size() - 1)));
+        }
+
+    private:
+        struct Node
+        {
+            int key, left, right, size;
+            uint32_t prio;
+            ll sum;
+        };
+        vector<Node> pool;
+        vector<int> freeList;
+        int root = 0;
+        uint32_t seed = 2463534242u;
+
+        uint32_t nextPrio()
+        {
+            seed ^= seed << 13;
+            seed ^= seed >> 17;
+            seed ^= seed << 5;
+            return seed;
+        }
+
+        int newNode(int x)
+        {
+            Node n = {x, 0, 0, 1, nextPrio(), x};
+            if(!freeList.empty())
+            {
+                int id = freeList.back();
+                freeList.pop_back();
+                pool[id] = n;
+                return id;
+            }
+            pool.push_back(n);
+            return (int)pool.size() - 1;
+        }
+
+        void pull(int t)
+        {
+            Node& n = pool[t];
+            n.size = pool[n.left].size + pool[n.right].size + 1;
+            n.sum = pool[n.left].sum + pool[n.right].sum + n.key;
+        }
+
+        // a gets the keys < x (<= x when orEqual), b the rest
+        void split(int t, int x, bool orEqual, int& a, int& b)
+        {
+            if(!t)
+            {
+                a = b = 0;
+                return;
+            }
+            if(pool[t].key < x || (orEqual && pool[t].key == x))
+            {
+                split(pool[t].right, x, orEqual, pool[t].right, b);
+                a = t;
+            }
+            else
+            {
+                split(pool[t].left, x, orEqual, a, pool[t].left);
+                b = t;
+            }
+            pull(t);
+        }
+
+        // Every key of a is <= every key of b
+        int merge(int a, int b)
+        {
+            if(!a || !b)
+                return a ? a : b;
+            if(pool[a].prio > pool[b].prio)
+            {
+                pool[a].right = merge(pool[a].right, b);
+                pull(a);
+                return a;
+            }
+            pool[b].left = merge(a, pool[b].left);
+            pull(b);
+            return b;
+        }
+};
+
+int main(int argc, char** argv)
+{
+    // The multiset from stl/sets.cpp, with the duplicate 50 kept
+    OrderStatisticTree t;
+    for(int x : {40, 30, 60, 20, 50, 50, 10})
+        t.insert(x);
+    printf("size %d, median %.1f, 2nd smallest %d, rank(50) %d, sum of [20, 50] %lld\n",
+           t.size(), t.median(), t.kth(1), t.rank(50), t.rangeSum(20, 50));
+    t.erase(50);
+    printf("after erasing one 50: median %.1f, 90th percentile %d\n", t.median(), t.percentile(90));
+
+    // Rolling median of a window
+    int n = argc > 1 ? atoi(argv[1]) : 200000;
+    int w = argc > 2 ? atoi(argv[2]) : 2001;
+    mt19937 rng(1);
+    vector<int> a(n);
+    for(auto& x : a)
+        x = (int)(rng() % 2000001) - 1000000;
+
+    auto start = chrono::steady_clock::now();
+    OrderStatisticTree win;
+    double treeSum = 0;
+    for(int i = 0; i < n; i++)
+    {
+        win.insert(a[i]);
+        if(i >= w)
+            win.erase(a[i - w]);
+        if(i >= w - 1)
+            treeSum += win.median();
+    }
+    double tTree = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    double nthSum = 0;
+    vector<int> buf(w);
+    for(int i = w - 1; i < n; i++)
+    {
+        copy(a.begin() + i - w + 1, a.begin() + i + 1, buf.begin());
+        nth_element(buf.begin(), buf.begin() + w / 2, buf.end());
+        double m = buf[w / 2];
+        if(w % 2 == 0)
+            m = (m + *max_element(buf.begin(), buf.begin() + w / 2)) / 2;
+        nthSum += m;
+    }
+    double tNth = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    printf("\nrolling median, n = %d, window %d\n", n, w);
+    printf("treap         %.3f s\n", tTree);
+    printf("nth_element   %.3f s  (%.1fx)\n", tNth, tNth / tTree);
+    printf(treeSum == nthSum ? "results match\n" : "MISMATCH\n");
+    return 0;
+}
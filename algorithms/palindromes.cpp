@@ -0,0 +1,277 @@
+// Palindromic substrings in linear time.
+//
+// longestPalindrome in leetcode/palindromicSubsequence.cpp fills a bool[n][n]
+// table on the stack: O(n^2) time, and n = 10^5 already needs 10 GB. Here:
+//
+//  - Manacher: odd[i] / even[i] are the number of palindromes centred at i
+//    (even: centred between i-1 and i). A palindrome found around centre c
+//    mirrors every centre inside it, so each new centre starts from its mirror's
+//    radius and the right end of the rightmost palindrome only moves forward:
+//    O(n) for all centres. isPalindrome(l, r) and the longest palindrome follow
+//    in O(1) / O(n).
+//  - Eertree (palindromic tree): one node per distinct palindrome, with an edge
+//    c from P to cPc and a suffix link to its longest proper palindromic suffix.
+//    Appending a character adds at most one node, so there are at most n + 2
+//    nodes. Edges live in one open-addressed hash table keyed by (node, byte)
+//    instead of a 256-entry array per node (10 GB for 10^7 characters) or
+//    per-node child lists (O(alphabet) per lookup at the roots, which have a
+//    child for almost every byte value). Counting how often each
+//    palindrome ends at some position and pushing the counts down the suffix
+//    links gives the occurrences of every distinct palindrome.
+//
+// Usage: ./palindromes [N]  runs both on N random characters (default 10^7).
+#include <bits/stdc++.h>
+using namespace std;
+
+struct Manacher
+{
+    vector<int> odd, even;
+
+    Manacher(string_view s) : odd(s.size()), even(s.size())
+    {
+        int n = (int)s.size();
+        for(int i = 0, l = 0, r = -1; i < n; i++)
+        {
+            int k = i > r ? 1 : min(odd[l + r - i], r - i + 1);
+            while(i - k >= 0 && i + k < n && s[i - k] == s[i + k])
+                k++;
+            odd[i] = k;
+            if(i + k - 1 > r)
+                l = i - k + 1, r = i + k - 1;
+        }
+        for(int i = 0, l = 0, r = -1; i < n; i++)
+        {
+            int k = i > r ? 0 : min(even[l + r - i + 1], r - i + 1);
+            while(i - k - 1 >= 0 && i + k < n && s[i - k - 1] == s[i + k])
+                k++;
+            even[i] = k;
+            if(i + k - 1 > r)
+                l = i - k, r = i + k - 1;
+        }
+    }
+
+    // s[l..r] (inclusive) is a palindrome
+    bool isPalindrome(int l, int r) const
+    {
+        int len = r - l + 1, mid = (l + r + 1) / 2;
+        return len % 2 ? odd[mid] * 2 - 1 >= len : even[mid] * 2 >= len;
+    }
+
+    // (start, length) of the leftmost longest palindrome
+    pair<int,int> longest() const
+    {
+        pair<int,int> best = {0, odd.empty() ? 0 : 1};
+        for(int i = 0; i < (int)odd.size(); i++)
+        {
+            if(odd[i] * 2 - 1 > best.second)
+                best = {i - odd[i] + 1, odd[i] * 2 - 1};
+            if(even[i] * 2 > best.second)
+                best = {i - even[i], even[i] * 2};
+        }
+        return best;
+    }
+
+    // Number of palindromic substrings counted with multiplicity
+    long long count() const
+    {
+        long long total = 0;
+        for(size_t i = 0; i < odd.size(); i++)
+            total += odd[i] + even[i];
+        return total;
+    }
+};
+
+class Eertree
+{
+    public:
+        Eertree(string_view s) : s(s)
+        {
+            nodes.reserve(s.size() + 2);
+            nodes.push_back({-1, 0, 0}); // 0: imaginary root, length -1
+            nodes.push_back({0, 0, 0});  // 1: empty string, links to 0
+            keys.assign(1024, 0);
+            vals.assign(1024, 0);
+            int last = 1;
+            for(int i = 0; i < (int)s.size(); i++)
+            {
+                unsigned char c = s[i];
+                int p = extendable(last, i);
+                int q = child(p, c);
+                if(q < 0)
+                {
+                    q = (int)nodes.size();
+                    int link = 1;
+                    if(nodes[p].len != -1)
+                        link = child(extendable(nodes[p].link, i), c);
+                    nodes.push_back({nodes[p].len + 2, link, 0});
+                    addChild(p, c, q);
+                }
+                nodes[q].count++;
+                last = q;
+            }
+            // A palindrome ending at i also ends its palindromic suffixes there. A
+            // suffix link always points to an older node, so one backward pass
+            // pushes the counts all the way down.
+            for(int v = (int)nodes.size() - 1; v >= 2; v--)
+                nodes[nodes[v].link].count += nodes[v].count;
+        }
+
+        // Non-empty distinct palindromic substrings
+        int distinct() const { return (int)nodes.size() - 2; }
+
+        // All substrings that are palindromes, with multiplicity
+        long long total() const
+        {
+            long long t = 0;
+            for(size_t v = 2; v < nodes.size(); v++)
+                t += nodes[v].count;
+            return t;
+        }
+
+        // (length, occurrences) of every distinct palindrome
+        vector<pair<int,int>> palindromes() const
+        {
+            vector<pair<int,int>> res;
+            for(size_t v = 2; v < nodes.size(); v++)
+                res.push_back({nodes[v].len, nodes[v].count});
+            return res;
+        }
+
+    private:
+        struct Node
+        {
+            int len, link;
+            int count; // end positions, at most n
+        };
+        string_view s;
+        vector<Node> nodes;
+        // Edge table: keys[i] = (node << 8 | byte) + 1, 0 = empty slot
+        vector<uint64_t> keys;
+        vector<int> vals;
+        size_t edges = 0;
+
+        // Follow suffix links from v until s[i - len - 1] == s[i], i.e. v can be
+        // extended by s[i] on both sides. The root (length -1) always can.
+        int extendable(int v, int i) const
+        {
+            while(i - nodes[v].len - 1 < 0 || s[i - nodes[v].len - 1] != s[i])
+                v = nodes[v].link;
+            return v;
+        }
+
+        static uint64_t edgeKey(int v, unsigned char c) { return ((uint64_t)v << 8 | c) + 1; }
+
+        size_t slot(uint64_t key) const
+        {
+            return (key * 0x9E3779B97F4A7C15ULL >> 17) & (keys.size() - 1);
+        }
+
+        int child(int v, unsigned char c) const
+        {
+            uint64_t key = edgeKey(v, c);
+            for(size_t i = slot(key); keys[i]; i = (i + 1) & (keys.size() - 1))
+                if(keys[i] == key)
+                    return vals[i];
+            return -1;
+        }
+
+        void addChild(int v, unsigned char c, int u)
+        {
+            if(2 * (edges + 1) > keys.size())
+            {
+                // Rehash into twice the space, keeping the load factor under 1/2
+                vector<uint64_t> oldKeys(2 * keys.size(), 0);
+                vector<int> oldVals(2 * vals.size(), 0);
+                oldKeys.swap(keys);
+                oldVals.swap(vals);
+                for(size_t i = 0; i < oldKeys.size(); i++)
+                    if(oldKeys[i])
+                        insert(oldKeys[i], oldVals[i]);
+            }
+            insert(edgeKey(v, c), u);
+            edges++;
+        }
+
+        void insert(uint64_t key, int u)
+        {
+            size_t i = slot(key);
+            while(keys[i])
+                i = (i + 1) & (keys.size() - 1);
+            keys[i] = key;
+            vals[i] = u;
+        }
+};
+
+// The O(n^2) table method on a heap-allocated table, for checking
+static pair<int,int> longestByTable(const string& s)
+{
+    int n = s.size();
+    if(n == 0)
+        return {0, 0};
+    vector<vector<char>> table(n, vector<char>(n, 0));
+    int start = 0, maxLength = 1;
+    for(int i = 0; i < n; i++)
+        table[i][i] = 1;
+    for(int k = 2; k <= n; k++)
+        for(int i = 0; i + k - 1 < n; i++)
+        {
+            int j = i + k - 1;
+            if(s[i] == s[j] && (k == 2 || table[i + 1][j - 1]))
+            {
+                table[i][j] = 1;
+                if(k > maxLength)
+                    start = i, maxLength = k;
+            }
+        }
+    return {start, maxLength};
+}
+
+int main(int argc, char** argv)
+{
+    string ex = "babad";
+    pair<int,int> p = Manacher(ex).longest();
+    cout << "longestPalindrome(\"" << ex << "\") = " << ex.substr(p.first, p.second) << endl;
+    Eertree et("abacaba");
+    cout << "abacaba: " << et.distinct() << " distinct palindromes, " << et.total() << " in total" << endl;
+
+    // Cross-check on small random strings
+    mt19937 rng(17);
+    bool ok = true;
+    for(int it = 0; it < 200; it++)
+    {
+        string s(rng() % 60, ' ');
+        for(auto& c : s)
+            c = 'a' + rng() % 3;
+        Manacher m(s);
+        ok &= m.longest().second == longestByTable(s).second;
+        ok &= Eertree(s).total() == m.count();
+        set<string> d;
+        for(size_t i = 0; i < s.size(); i++)
+            for(size_t j = i; j < s.size(); j++)
+                if(m.isPalindrome(i, j))
+                    d.insert(s.substr(i, j - i + 1));
+        ok &= (int)d.size() == Eertree(s).distinct();
+    }
+
+    // Two letters (long palindromes, deep tree) and all 256 byte values (wide roots)
+    int n = argc > 1 ? atoi(argv[1]) : 10000000;
+    cout << endl;
+    for(int sigma : {2, 256})
+    {
+        string big(n, ' ');
+        for(auto& c : big)
+            c = sigma == 2 ? 'a' + rng() % 2 : (char)(rng() % 256);
+        auto start = chrono::steady_clock::now();
+        Manacher m(big);
+        pair<int,int> best = m.longest();
+        double tMan = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        start = chrono::steady_clock::now();
+        Eertree tree(big);
+        double tTree = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cout << n << " characters, alphabet " << sigma << ": Manacher " << tMan * 1000 << " ms (longest "
+             << best.second << "), eertree " << tTree * 1000 << " ms (" << tree.distinct() << " distinct)" << endl;
+        ok &= tree.total() == m.count();
+    }
+    cout << (ok ? "results match" : "MISMATCH") << endl;
+    return 0;
+}
@@ -0,0 +1,235 @@
+// Single pattern substring search with SIMD candidate filtering.
+//
+// KMPSearch in patternMatchingString_wellsFargo.cpp copies both strings and
+// looks at one text byte per iteration. SubstringSearch takes string_views and
+// filters candidate positions 32 (AVX2) or 16 (SSE2) at a time: a position i
+// can only start a match if txt[i] == pat[0] and txt[i + m - 1] == pat[m - 1],
+// which is two vector compares and an AND. Only the surviving bits are checked
+// with memcmp, and on ordinary text that is a tiny fraction of the positions.
+//
+// The filter is useless when almost every position survives it, e.g. pattern
+// a^k b a^k in a run of a's: each candidate is then verified for ~k bytes. The
+// search counts the bytes it spends verifying and, once that exceeds a few times
+// the bytes scanned, finishes with KMP (the failure table is built up front), so
+// the worst case stays O(n + m).
+//
+// Usage: ./simdSubstringSearch [MB]  counts a pattern in MB megabytes of text
+// (default 1024) with KMP and with the SIMD filter. Compile with -O2 -mavx2.
+#include <bits/stdc++.h>
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+using namespace std;
+
+class SubstringSearch
+{
+    public:
+        static const size_t npos = string_view::npos;
+
+        SubstringSearch(string_view pat) : pat(pat), lps(pat.size(), 0)
+        {
+            // computeLPSArray from patternMatchingString_wellsFargo.cpp
+            for(size_t i = 1, len = 0; i < pat.size(); )
+            {
+                if(pat[i] == pat[len])
+                    lps[i++] = (int)++len;
+                else if(len)
+                    len = lps[len - 1];
+                else
+                    lps[i++] = 0;
+            }
+        }
+
+        // First match starting at or after `from`, npos if none
+        size_t find(string_view txt, size_t from = 0) const
+        {
+            size_t res = npos;
+            scan(txt, from, [&](size_t i) { res = i; return false; });
+            return res;
+        }
+
+        // Number of (possibly overlapping) matches
+        size_t count(string_view txt) const
+        {
+            size_t res = 0;
+            scan(txt, 0, [&](size_t) { res++; return true; });
+            return res;
+        }
+
+        // Calls f(start) for each match in order while f returns true
+        template<class F>
+        void forEach(string_view txt, F f) const { scan(txt, 0, f); }
+
+    private:
+        string pat; // owned, so the searcher may outlive the string it was built from
+        vector<int> lps;
+
+        template<class F>
+        void scan(string_view txt, size_t from, F f) const
+        {
+            const size_t n = txt.size(), m = pat.size();
+            if(m == 0)
+            {
+                for(size_t i = from; i <= n; i++)
+                    if(!f(i))
+                        return;
+                return;
+            }
+            if(n < m || from > n - m)
+                return;
+            const char* s = txt.data();
+            const char first = pat[0], last = pat[m - 1];
+            const size_t end = n - m + 1; // candidate starts are [from, end)
+            size_t i = from, verified = 0;
+            // Verification budget: past this the filter is not paying off
+            auto overBudget = [&]() { return verified > 4 * (i - from) + 4096; };
+
+            auto check = [&](size_t pos) {
+                verified += m;
+                return memcmp(s + pos + 1, pat.data() + 1, m - 1) == 0;
+            };
+#if defined(__AVX2__)
+            const __m256i vf = _mm256_set1_epi8(first), vl = _mm256_set1_epi8(last);
+            for(; i + 32 <= end; i += 32)
+            {
+                __m256i a = _mm256_loadu_si256((const __m256i*)(s + i));
+                __m256i b = _mm256_loadu_si256((const __m256i*)(s + i + m - 1));
+                unsigned mask = (unsigned)_mm256_movemask_epi8(
+                    _mm256_and_si256(_mm256_cmpeq_epi8(a, vf), _mm256_cmpeq_epi8(b, vl)));
+                for(; mask; mask &= mask - 1)
+                {
+                    size_t pos = i + __builtin_ctz(mask);
+                    if(check(pos) && !f(pos))
+                        return;
+                }
+                if(overBudget())
+                    return kmp(txt, i + 32, f);
+            }
+#elif defined(__SSE2__)
+            const __m128i vf = _mm_set1_epi8(first), vl = _mm_set1_epi8(last);
+            for(; i + 16 <= end; i += 16)
+            {
+                __m128i a = _mm_loadu_si128((const __m128i*)(s + i));
+                __m128i b = _mm_loadu_si128((const __m128i*)(s + i + m - 1));
+                unsigned mask = (unsigned)_mm_movemask_epi8(
+                    _mm_and_si128(_mm_cmpeq_epi8(a, vf), _mm_cmpeq_epi8(b, vl)));
+                for(; mask; mask &= mask - 1)
+                {
+                    size_t pos = i + __builtin_ctz(mask);
+                    if(check(pos) && !f(pos))
+                        return;
+                }
+                if(overBudget())
+                    return kmp(txt, i + 16, f);
+            }
+#endif
+            // Whatever the vector loop left, or everything on targets without SSE2
+            for(; i < end; i++)
+                if(s[i] == first && s[i + m - 1] == last)
+                {
+                    if(check(i) && !f(i))
+                        return;
+                    if(overBudget())
+                        return kmp(txt, i + 1, f);
+                }
+        }
+
+        // KMPSearch for the starts >= from (proper overlapping matches, linear time)
+        template<class F>
+        void kmp(string_view txt, size_t from, F f) const
+        {
+            const size_t m = pat.size();
+            size_t j = 0;
+            for(size_t i = from; i < txt.size(); i++)
+            {
+                while(j > 0 && txt[i] != pat[j])
+                    j = lps[j - 1];
+                if(txt[i] == pat[j])
+                    j++;
+                if(j == m)
+                {
+                    if(!f(i + 1 - m))
+                        return;
+                    j = lps[j - 1];
+                }
+            }
+        }
+};
+
+// KMPSearch from patternMatchingString_wellsFargo.cpp with the restart logic
+// replaced by the usual j = lps[j-1], so it counts overlapping matches in O(n + m).
+// Sizes are size_t so that texts over 2 GB work, and the strings are no longer copied.
+size_t KMPSearch(const string& pat, const string& txt)
+{
+    size_t M = pat.size(), N = txt.size();
+    vector<int> lps(M, 0);
+    for(size_t i = 1, len = 0; i < M; )
+    {
+        if(pat[i] == pat[len])
+            lps[i++] = (int)++len;
+        else if(len)
+            len = lps[len - 1];
+        else
+            lps[i++] = 0;
+    }
+    size_t res = 0;
+    for(size_t i = 0, j = 0; i < N; i++)
+    {
+        while(j > 0 && txt[i] != pat[j])
+            j = lps[j - 1];
+        if(txt[i] == pat[j])
+            j++;
+        if(j == M)
+        {
+            res++;
+            j = lps[j - 1];
+        }
+    }
+    return res;
+}
+
+template<class F>
+double timeIt(F f)
+{
+    auto start = chrono::steady_clock::now();
+    f();
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv)
+{
+    string txt = "eekseeksgeeekseksforgeekseeeeeeekseeksekeeeeksks";
+    printf("eeks occurs %zu times\n", SubstringSearch("eeks").count(txt));
+
+    size_t mb = argc > 1 ? atol(argv[1]) : 1024;
+    size_t n = mb << 20;
+    // Lower case text, filled 8 bytes at a time
+    string text(n, ' ');
+    uint64_t x = 88172645463325252ULL;
+    for(size_t i = 0; i + 8 <= n; i += 8)
+    {
+        x ^= x << 13, x ^= x >> 7, x ^= x << 17;
+        for(int k = 0; k < 8; k++)
+            text[i + k] = 'a' + ((x >> (8 * k)) & 0xff) % 26;
+    }
+    string pat = "needle";
+    for(size_t i = 1; i <= 1000; i++)
+        text.replace(n / 1001 * i, pat.size(), pat);
+
+    size_t a = 0, b = 0;
+    double tKmp = timeIt([&]() { a = KMPSearch(pat, text); });
+    double tSimd = timeIt([&]() { b = SubstringSearch(pat).count(text); });
+    printf("\n%zu MB of text, pattern \"%s\"\n", mb, pat.c_str());
+    printf("KMPSearch         %.3f s\n", tKmp);
+    printf("SubstringSearch   %.3f s  (%.1fx, %.2f GB/s)\n", tSimd, tKmp / tSimd, n / tSimd / 1e9);
+    printf(a == b ? "results match (%zu)\n" : "MISMATCH\n", a);
+
+    // Pathological: a^k b a^k in a run of a's, every position passes the filter
+    string run(min(n, (size_t)64 << 20), 'a');
+    string bad = string(500, 'a') + "b" + string(500, 'a');
+    run[run.size() / 2] = 'b';
+    double tBad = timeIt([&]() { b = SubstringSearch(bad).count(run); });
+    printf("\nperiodic pattern on %zu MB of a's: %.3f s, %zu match(es) (KMP fallback)\n",
+           run.size() >> 20, tBad, b);
+    return 0;
+}
@@ -0,0 +1,428 @@
+// Longest windows of distinct symbols over a byte stream.
+//
+// lengthOfLongestSubstring (leetcode/longestSubsequenceWithoutRepeatingCharacters.cpp)
+// keeps the last index of every character and moves the left end of the window
+// past the previous occurrence of the character just read. DistinctWindows runs
+// the same idea as a stream: input arrives in chunks of any size, positions are
+// 64-bit, and the only state is one "last seen" entry per symbol.
+//
+//  - Symbols are raw bytes (DistinctWindows<false>, always unsigned) or UTF-8
+//    code points (DistinctWindows<true>). The decoder keeps a partial sequence
+//    across chunk boundaries; bytes that are not valid UTF-8 (overlong forms,
+//    surrogates, stray continuation bytes) each become a symbol of their own
+//    outside the Unicode range, so nothing is silently dropped. Runs of 16 ASCII
+//    bytes are recognised with one SSE2 compare and skip the decoder.
+//  - unique(): the longest window without a repeated symbol.
+//  - kDistinct(): the longest window with at most k distinct symbols. The
+//    symbols in the window are kept in a list ordered by last occurrence; when a
+//    (k+1)-th one arrives, the head of the list (the one seen longest ago) is
+//    evicted and the window starts right after its last occurrence. That is
+//    O(1) per symbol for any k and never looks back at old input.
+//
+// Windows are reported as symbol index + length and as byte offset + length.
+//
+// Usage: ./slidingWindowDistinct [-u] [-k K] FILE   scan a file (-u: UTF-8)
+//        ./slidingWindowDistinct [--bench MB]        self check + benchmark (default 1024 MB)
+#include <bits/stdc++.h>
+#include <fcntl.h>
+#include <unistd.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+using namespace std;
+
+struct Window
+{
+    uint64_t start = 0, length = 0;         // in symbols
+    uint64_t byteStart = 0, byteLength = 0; // in the input
+};
+
+template<bool Utf8>
+class DistinctWindows
+{
+    public:
+        // Bytes, or code points plus one symbol per invalid byte value
+        static constexpr uint32_t Alphabet = Utf8 ? 0x110000 + 256 : 256;
+
+        DistinctWindows(uint32_t k = 0) : k(k), last(Alphabet, 0)
+        {
+            if(Utf8)
+                lastEnd.assign(Alphabet, 0);
+            if(k)
+            {
+                // Circular list with a sentinel node at index Alphabet
+                prev.assign(Alphabet + 1, Alphabet);
+                next.assign(Alphabet + 1, Alphabet);
+            }
+        }
+
+        void feed(const char* data, size_t len)
+        {
+            const unsigned char* p = (const unsigned char*)data;
+            // A local copy: stores into last[] could alias the members, so
+            // updating them in place would reload them for every symbol
+            Cursor s = cur;
+            if(!Utf8)
+            {
+                for(size_t i = 0; i < len; i++)
+                    push(s, p[i], bytes + i + 1);
+                cur = s;
+                bytes += len;
+                return;
+            }
+            size_t i = 0;
+            while(i < len)
+            {
+#if defined(__SSE2__)
+                if(!need && i + 16 <= len
+                   && !_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)(p + i))))
+                {
+                    for(size_t e = i + 16; i < e; i++)
+                        push(s, p[i], bytes + i + 1);
+                    continue;
+                }
+#endif
+                decode(s, p[i], bytes + i);
+                i++;
+            }
+            cur = s;
+            bytes += len;
+        }
+
+        // End of input: an unfinished UTF-8 sequence counts as invalid bytes
+        void finish()
+        {
+            if(Utf8)
+                flushPending(cur);
+        }
+
+        Window unique() const { return cur.bestUnique; }
+        Window kDistinct() const { return cur.bestK; }
+        uint64_t symbols() const { return cur.pos; }
+
+    private:
+        uint32_t k;
+        vector<uint64_t> last;    // index + 1 of the last occurrence, 0 = never
+        vector<uint64_t> lastEnd; // UTF-8: byte offset just after it
+        vector<uint32_t> prev, next; // symbols of the k window, oldest first
+        uint64_t bytes = 0;
+
+        struct Cursor
+        {
+            uint64_t pos = 0;                  // symbols so far
+            uint64_t left = 0, leftByte = 0;   // unique window (leftByte: UTF-8 only)
+            uint64_t kLeft = 0, kLeftByte = 0; // k-distinct window
+            uint32_t inWindow = 0;
+            Window bestUnique, bestK;
+        } cur;
+
+        // UTF-8 decoder state
+        uint32_t cp = 0;
+        int need = 0, pending = 0;
+        uint64_t pendingStart = 0;
+        unsigned char lead = 0;
+
+        // Where the previous occurrence of c ends, in bytes
+        uint64_t endOf(uint32_t c) const { return Utf8 ? lastEnd[c] : last[c]; }
+
+        void push(Cursor& s, uint32_t c, uint64_t byteEnd)
+        {
+            // Branch-free: on random text the window moves on about every symbol
+            uint64_t seen = last[c];
+            if(Utf8)
+                s.leftByte = seen > s.left ? lastEnd[c] : s.leftByte;
+            s.left = max(s.left, seen);
+            if(k)
+            {
+                bool in = seen > s.kLeft;
+                if(s.inWindow < k && !in)
+                    s.inWindow++; // still filling up
+                else
+                {
+                    // c moves to the back of the list, or (if it is new) the symbol
+                    // seen longest ago is dropped and the window starts after it.
+                    // Selects instead of branches, "in" is a coin flip on most text.
+                    uint32_t h = next[Alphabet];
+                    uint64_t hLast = last[h], hEnd = endOf(h);
+                    s.kLeftByte = in ? s.kLeftByte : hEnd;
+                    s.kLeft = in ? s.kLeft : hLast;
+                    unlink(in ? c : h);
+                }
+            }
+            last[c] = ++s.pos;
+            if(Utf8)
+                lastEnd[c] = byteEnd;
+            if(k)
+            {
+                append(c);
+                if(s.pos - s.kLeft > s.bestK.length)
+                    s.bestK = {s.kLeft, s.pos - s.kLeft, s.kLeftByte, byteEnd - s.kLeftByte};
+            }
+            if(s.pos - s.left > s.bestUnique.length)
+            {
+                uint64_t from = Utf8 ? s.leftByte : s.left; // bytes: symbol index = offset
+                s.bestUnique = {s.left, s.pos - s.left, from, byteEnd - from};
+            }
+        }
+
+        void unlink(uint32_t c)
+        {
+            next[prev[c]] = next[c];
+            prev[next[c]] = prev[c];
+        }
+
+        void append(uint32_t c)
+        {
+            uint32_t t = prev[Alphabet];
+            prev[c] = t;
+            next[c] = Alphabet;
+            next[t] = c;
+            prev[Alphabet] = c;
+        }
+
+        void decode(Cursor& s, unsigned char b, uint64_t at)
+        {
+            if(need)
+            {
+                // Second byte limits rule out overlong forms, surrogates and > U+10FFFF
+                bool ok = (b & 0xC0) == 0x80;
+                if(ok && pending == 1)
+                    ok = !(lead == 0xE0 && b < 0xA0) && !(lead == 0xED && b > 0x9F)
+                      && !(lead == 0xF0 && b < 0x90) && !(lead == 0xF4 && b > 0x8F);
+                if(ok)
+                {
+                    cp = cp << 6 | (b & 0x3F);
+                    pending++;
+                    if(--need == 0)
+                    {
+                        pending = 0;
+                        push(s, cp, at + 1);
+                    }
+                    return;
+                }
+                flushPending(s);
+            }
+            if(b < 0x80)
+                push(s, b, at + 1);
+            else if(b >= 0xC2 && b <= 0xF4)
+            {
+                need = b < 0xE0 ? 1 : b < 0xF0 ? 2 : 3;
+                cp = b & (0x3F >> need);
+                lead = b;
+                pending = 1;
+                pendingStart = at;
+            }
+            else
+                push(s, 0x110000 + b, at + 1);
+        }
+
+        // The bytes of a broken sequence, one invalid-byte symbol each. Only the
+        // lead byte is needed: a continuation byte c is 0x80 | (bits of cp).
+        void flushPending(Cursor& s)
+        {
+            for(int i = 0; i < pending; i++)
+            {
+                unsigned char byte = i == 0 ? lead : 0x80 | ((cp >> (6 * (pending - 1 - i))) & 0x3F);
+                push(s, 0x110000 + byte, pendingStart + i + 1);
+            }
+            need = pending = 0;
+        }
+};
+
+// lengthOfLongestSubstring with the character as unsigned char
+int lengthOfLongestSubstring(const string& s)
+{
+    vector<int> m(256, -1);
+    int i = 0, res = 0;
+    for(int j = 0; j < (int)s.length(); j++)
+    {
+        unsigned char c = s[j];
+        i = max(i, m[c] + 1);
+        m[c] = j;
+        res = max(res, j - i + 1);
+    }
+    return res;
+}
+
+// Quadratic reference over a decoded symbol sequence
+static uint64_t longestAtMostK(const vector<uint32_t>& sym, uint32_t k)
+{
+    uint64_t best = 0;
+    for(size_t i = 0; i < sym.size(); i++)
+    {
+        set<uint32_t> seen;
+        for(size_t j = i; j < sym.size(); j++)
+        {
+            seen.insert(sym[j]);
+            if(seen.size() > k)
+                break;
+            best = max<uint64_t>(best, j - i + 1);
+        }
+    }
+    return best;
+}
+
+template<bool Utf8, class F>
+static void feedInChunks(DistinctWindows<Utf8>& w, const string& s, F nextChunk)
+{
+    for(size_t i = 0; i < s.size(); )
+    {
+        size_t len = min(s.size() - i, (size_t)nextChunk());
+        w.feed(s.data() + i, len);
+        i += len;
+    }
+    w.finish();
+}
+
+template<bool Utf8>
+static int scan(const char* path, uint32_t k)
+{
+    int fd = open(path, O_RDONLY);
+    if(fd < 0)
+    {
+        perror(path);
+        return 1;
+    }
+    DistinctWindows<Utf8> w(k);
+    vector<char> buf(1 << 20);
+    auto start = chrono::steady_clock::now();
+    ssize_t got;
+    while((got = read(fd, buf.data(), buf.size())) > 0 || (got < 0 && errno == EINTR))
+        if(got > 0)
+            w.feed(buf.data(), got);
+    close(fd);
+    if(got < 0)
+    {
+        perror(path);
+        return 1;
+    }
+    w.finish();
+    double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    auto show = [](const char* what, Window win) {
+        printf("%s: %llu symbols at symbol %llu (bytes %llu..%llu)\n", what, (unsigned long long)win.length,
+               (unsigned long long)win.start, (unsigned long long)win.byteStart,
+               (unsigned long long)(win.byteStart + win.byteLength));
+    };
+    show("longest unique window", w.unique());
+    if(k)
+        show(("longest window with <= " + to_string(k) + " distinct").c_str(), w.kDistinct());
+    printf("%llu symbols in %.3f s\n", (unsigned long long)w.symbols(), secs);
+    return 0;
+}
+
+// Non-negative decimal that fits in 32 bits, the whole string
+static bool parseCount(const char* s, uint32_t& out)
+{
+    if(!isdigit((unsigned char)*s))
+        return false;
+    char* end;
+    errno = 0;
+    unsigned long long v = strtoull(s, &end, 10);
+    if(*end || errno || v > UINT32_MAX)
+        return false;
+    out = (uint32_t)v;
+    return true;
+}
+
+static int usage(const char* prog)
+{
+    fprintf(stderr, "usage: %s [-u] [-k K] FILE\n       %s [--bench MB]\n", prog, prog);
+    return 2;
+}
+
+int main(int argc, char** argv)
+{
+    bool utf8 = false, bench = false;
+    uint32_t k = 0, mbArg = 1024;
+    const char* path = nullptr;
+    for(int i = 1; i < argc; i++)
+    {
+        if(!strcmp(argv[i], "-u"))
+            utf8 = true;
+        else if(!strcmp(argv[i], "-k") && i + 1 < argc && parseCount(argv[i + 1], k))
+            i++;
+        else if(!strcmp(argv[i], "--bench") && i + 1 < argc && parseCount(argv[i + 1], mbArg))
+            bench = true, i++;
+        else if(argv[i][0] != '-' && !path)
+            path = argv[i];
+        else
+            return usage(argv[0]);
+    }
+    // Scan options and benchmark options do not mix
+    if(path ? bench : utf8 || k)
+        return usage(argv[0]);
+    if(path)
+        return utf8 ? scan<true>(path, k) : scan<false>(path, k);
+
+    // Self check: every chunking gives the answer of the quadratic reference
+    mt19937 rng(50);
+    bool ok = lengthOfLongestSubstring("abcabcbb") == 3 && lengthOfLongestSubstring("\xc3\xa9t\xc3\xa9") == 3;
+    const char* pieces[] = {"a", "b", "c", "\xc3\xa9", "\xe2\x82\xac", "\xf0\x9f\x98\x80", "\xff", "\xc3", "\xed\xa0\x80", "\xe0\x80"};
+    for(int it = 0; it < 300; it++)
+    {
+        string s;
+        int parts = rng() % 60;
+        for(int p = 0; p < parts; p++)
+            s += pieces[rng() % (it % 2 ? 10 : 3)];
+        uint32_t k = 1 + rng() % 4;
+        auto chunk = [&]() { return 1 + rng() % 5; };
+
+        DistinctWindows<false> bw(k);
+        feedInChunks(bw, s, chunk);
+        vector<uint32_t> bsym(s.begin(), s.end());
+        for(auto& c : bsym)
+            c &= 0xFF;
+        ok &= bw.unique().length == (uint64_t)lengthOfLongestSubstring(s);
+        ok &= bw.kDistinct().length == longestAtMostK(bsym, k);
+
+        // Decode with a one-shot pass (whole string, chunk = everything) and check
+        // the windows against the symbols it produced
+        DistinctWindows<true> uw(k), whole(k);
+        feedInChunks(uw, s, chunk);
+        feedInChunks(whole, s, [&]() { return s.size() + 1; });
+        ok &= uw.symbols() == whole.symbols() && uw.unique().length == whole.unique().length;
+        ok &= uw.kDistinct().byteLength == whole.kDistinct().byteLength;
+        Window u = uw.unique();
+        string sub = s.substr(u.byteStart, u.byteLength);
+        DistinctWindows<true> again(k);
+        feedInChunks(again, sub, chunk);
+        ok &= again.symbols() == u.length;
+    }
+    // Reported windows really are unique / k-distinct
+    string text = "abcd\xc3\xa9" "ebcabcbbd\xc3\xa9\xc3\xa9";
+    DistinctWindows<true> tw(2);
+    tw.feed(text.data(), text.size());
+    tw.finish();
+    cout << "longest unique window: \"" << text.substr(tw.unique().byteStart, tw.unique().byteLength) << "\"" << endl;
+    cout << "longest window with <= 2 distinct: \"" << text.substr(tw.kDistinct().byteStart, tw.kDistinct().byteLength) << "\"" << endl;
+
+    // Benchmark: chunks of 1 MB
+    size_t mb = mbArg;
+    string big(mb << 20, ' ');
+    for(size_t i = 0; i < big.size(); i += 8)
+    {
+        uint64_t r = rng() * 0x9E3779B97F4A7C15ULL;
+        for(int b = 0; b < 8 && i + b < big.size(); b++)
+            big[i + b] = 'a' + ((r >> (8 * b)) & 0xFF) % 26;
+    }
+    auto run = [&](auto& w) {
+        auto start = chrono::steady_clock::now();
+        for(size_t i = 0; i < big.size(); i += 1 << 20)
+            w.feed(big.data() + i, min(big.size() - i, (size_t)1 << 20));
+        w.finish();
+        return big.size() / 1e9 / chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    };
+    DistinctWindows<false> bytesUnique, bytesK(8);
+    DistinctWindows<true> utf8K(8);
+    double g1 = run(bytesUnique), g2 = run(bytesK), g3 = run(utf8K);
+    double gLeet = big.size() / 1e9 / chrono::duration<double>([&]() {
+        auto start = chrono::steady_clock::now();
+        ok &= (uint64_t)lengthOfLongestSubstring(big) == bytesUnique.unique().length;
+        return chrono::steady_clock::now() - start;
+    }()).count();
+    ok &= bytesK.kDistinct().length == utf8K.kDistinct().length;
+    printf("\n%zu MB: unique bytes %.2f GB/s, k = 8 bytes %.2f GB/s, k = 8 UTF-8 %.2f GB/s, lengthOfLongestSubstring %.2f GB/s\n",
+           mb, g1, g2, g3, gLeet);
+    printf(ok ? "results match\n" : "MISMATCH\n");
+    return 0;
+}
@@ -0,0 +1,188 @@
+// Resumable KMP matching over inputs of any size.
+//
+// KMPSearch (patternMatchingString_wellsFargo.cpp) needs the whole text in one
+// string. The only state the LPS walk really carries from one text byte to the
+// next is j, the length of the pattern prefix matched so far, so KMPMatcher keeps
+// just that (plus the stream offset) between feed() calls. Input can be cut into
+// chunks anywhere and a match that straddles a cut is still reported, at its
+// absolute offset in the stream. Memory is O(pattern) plus the reader's buffer:
+//
+//  - scanFile maps a regular file in fixed windows (64 MB) with mmap and unmaps
+//    each window once it has been fed, so the resident set stays bounded
+//  - scanFd read()s a pipe / stdin / socket into one 64 KB buffer
+//
+// While j == 0 the matcher jumps to the next occurrence of pat[0] with memchr,
+// which skips most of a typical log in vectorised library code.
+//
+// Usage: ./streamingKMP PATTERN [FILE]   counts PATTERN in FILE (mmap) or in stdin
+//        ./streamingKMP                  runs a small self check
+#include <bits/stdc++.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+using namespace std;
+
+class KMPMatcher
+{
+    public:
+        KMPMatcher(const string& pat) : pat(pat), lps(pat.size(), 0)
+        {
+            if(pat.empty())
+                throw invalid_argument("empty pattern");
+            // computeLPSArray
+            for(size_t i = 1, len = 0; i < pat.size(); )
+            {
+                if(pat[i] == pat[len])
+                    lps[i++] = ++len;
+                else if(len)
+                    len = lps[len - 1];
+                else
+                    lps[i++] = 0;
+            }
+        }
+
+        // Calls onMatch(start offset in the stream) for every match ending in this chunk
+        template<class F>
+        void feed(const char* data, size_t len, F onMatch)
+        {
+            const size_t m = pat.size();
+            const char* end = data + len;
+            const char* p = data;
+            size_t j = state;
+            while(p < end)
+            {
+                if(j == 0)
+                {
+                    p = (const char*)memchr(p, pat[0], end - p);
+                    if(!p)
+                        break;
+                }
+                while(j > 0 && *p != pat[j])
+                    j = lps[j - 1];
+                if(*p == pat[j])
+                    j++;
+                p++;
+                if(j == m)
+                {
+                    onMatch(offset + (p - data) - m);
+                    j = lps[j - 1];
+                }
+            }
+            state = j;
+            offset += len;
+        }
+
+        void reset() { state = 0; offset = 0; }
+        uint64_t consumed() const { return offset; }
+
+    private:
+        string pat;
+        vector<size_t> lps;
+        size_t state = 0;    // the j of the LPS walk
+        uint64_t offset = 0; // stream position of the next byte
+};
+
+// Feeds a regular file through the matcher window by window, false if it cannot be mapped
+template<class F>
+bool scanFile(const char* path, KMPMatcher& matcher, F onMatch, size_t window = (size_t)64 << 20)
+{
+    int fd = open(path, O_RDONLY);
+    if(fd < 0)
+        return false;
+    struct stat st;
+    if(fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+    {
+        close(fd);
+        return false;
+    }
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    window = max(page, window / page * page);
+    for(off_t pos = 0; pos < st.st_size; pos += window)
+    {
+        size_t len = (size_t)min<off_t>(window, st.st_size - pos);
+        void* map = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, pos);
+        if(map == MAP_FAILED)
+        {
+            close(fd);
+            return false;
+        }
+        madvise(map, len, MADV_SEQUENTIAL);
+        matcher.feed((const char*)map, len, onMatch);
+        munmap(map, len);
+    }
+    close(fd);
+    return true;
+}
+
+// Feeds everything readable from fd (pipe, stdin, socket, file)
+template<class F>
+bool scanFd(int fd, KMPMatcher& matcher, F onMatch, size_t bufferSize = 1 << 16)
+{
+    vector<char> buf(bufferSize);
+    while(true)
+    {
+        ssize_t got = read(fd, buf.data(), buf.size());
+        if(got < 0 && errno == EINTR)
+            continue;
+        if(got < 0)
+            return false;
+        if(got == 0)
+            return true;
+        matcher.feed(buf.data(), (size_t)got, onMatch);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if(argc < 2)
+    {
+        // The example from patternMatchingString_wellsFargo.cpp, fed in every chunk size
+        string txt = "eekseeksgeeekseksforgeekseeeeeeekseeksekeeeeksks";
+        KMPMatcher whole("eeks");
+        vector<uint64_t> expected;
+        whole.feed(txt.data(), txt.size(), [&](uint64_t at) { expected.push_back(at); });
+        bool ok = true;
+        for(size_t chunk = 1; chunk <= txt.size(); chunk++)
+        {
+            KMPMatcher m("eeks");
+            vector<uint64_t> got;
+            for(size_t i = 0; i < txt.size(); i += chunk)
+                m.feed(txt.data() + i, min(chunk, txt.size() - i), [&](uint64_t at) { got.push_back(at); });
+            ok &= got == expected;
+        }
+        printf("eeks occurs %zu times, same result for every chunk size: %s\n",
+               expected.size(), ok ? "yes" : "no");
+        return 0;
+    }
+
+    KMPMatcher matcher(argv[1]);
+    uint64_t count = 0, first = UINT64_MAX;
+    auto onMatch = [&](uint64_t at) {
+        if(!count++)
+            first = at;
+    };
+    auto start = chrono::steady_clock::now();
+    bool ok = argc > 2 ? scanFile(argv[2], matcher, onMatch) : scanFd(STDIN_FILENO, matcher, onMatch);
+    if(!ok)
+    {
+        // Not mappable (e.g. a named pipe): fall back to reading it
+        int fd = argc > 2 ? open(argv[2], O_RDONLY) : -1;
+        matcher.reset();
+        count = 0;
+        ok = fd >= 0 && scanFd(fd, matcher, onMatch);
+        if(fd >= 0)
+            close(fd);
+    }
+    if(!ok)
+    {
+        perror(argc > 2 ? argv[2] : "stdin");
+        return 1;
+    }
+    double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    printf("%llu matches", (unsigned long long)count);
+    if(count)
+        printf(", first at byte %llu", (unsigned long long)first);
+    printf("\n%llu bytes in %.3f s\n", (unsigned long long)matcher.consumed(), secs);
+    return 0;
+}
@@ -0,0 +1,385 @@
+// Suffix array (SA-IS) + LCP (Kasai) + RMQ: one index for many string questions.
+//
+// prefix_function in prefixFunctionTrivial.cpp compares substr()s, O(n^3) with an
+// allocation per comparison, and findMinimumShiftLCP_wellsFargo.cpp runs a KMP
+// scan per question. SuffixArray is built once in O(n):
+//
+//  - SA-IS: suffixes are typed S or L (smaller / larger than the next suffix),
+//    the LMS substrings are sorted by two induced-sorting passes, renamed, and
+//    the recursion on the renamed string fixes their final order, from which a
+//    last induced pass sorts everything.
+//  - Kasai: lcp[i] = LCP(sa[i], sa[i+1]), using that the LCP drops by at most one
+//    when moving from suffix i to suffix i+1 in text order.
+//  - MinRMQ over lcp: blocks of 64 with a sparse table over block minima and a
+//    min-stack bitmask per position inside a block (as in graphs/treeLCA.cpp),
+//    O(n) words and O(1) per query.
+//
+// With those, lcp(i, j) of any two suffixes is one RMQ, and the rest follows:
+// Z-function and prefix function, occurrence counting, longest repeated
+// substring, number of distinct substrings, minimum rotation and the best
+// rotation shift of findMinimumShiftLCP.
+#include <bits/stdc++.h>
+using namespace std;
+
+class MinRMQ
+{
+    public:
+        MinRMQ() {}
+        MinRMQ(const vector<int>& a) : a(a), mask(a.size())
+        {
+            int n = (int)a.size(), blocks = (n + B - 1) / B;
+            vector<int> blockMin(blocks);
+            for(int b = 0; b < blocks; b++)
+            {
+                int lo = b * B, hi = min(n, lo + B);
+                uint64_t cur = 0;
+                for(int i = lo; i < hi; i++)
+                {
+                    while(cur && a[lo + 63 - __builtin_clzll(cur)] >= a[i])
+                        cur ^= 1ULL << (63 - __builtin_clzll(cur));
+                    cur |= 1ULL << (i - lo);
+                    mask[i] = cur;
+                }
+                blockMin[b] = a[lo + __builtin_ctzll(mask[hi-1])];
+            }
+            sparse.push_back(blockMin);
+            for(int k = 1; (1 << k) <= blocks; k++)
+            {
+                const vector<int>& prev = sparse[k-1];
+                vector<int> cur(blocks - (1 << k) + 1);
+                for(size_t b = 0; b < cur.size(); b++)
+                    cur[b] = min(prev[b], prev[b + (1 << (k-1))]);
+                sparse.push_back(move(cur));
+            }
+        }
+
+        // min of a[l..r], l <= r
+        int query(int l, int r) const
+        {
+            int bl = l / B, br = r / B;
+            if(bl == br)
+                return inBlock(l, r);
+            int best = min(inBlock(l, bl * B + B - 1), inBlock(br * B, r));
+            if(bl + 1 < br)
+            {
+                int k = 31 - __builtin_clz(br - bl - 1);
+                best = min({best, sparse[k][bl+1], sparse[k][br - (1 << k)]});
+            }
+            return best;
+        }
+
+    private:
+        static const int B = 64;
+        vector<int> a;
+        vector<uint64_t> mask;
+        vector<vector<int>> sparse;
+
+        int inBlock(int l, int r) const
+        {
+            int lo = l / B * B;
+            return a[lo + __builtin_ctzll(mask[r] >> (l - lo) << (l - lo))];
+        }
+};
+
+// Suffix array of s, values in [0, upper]
+vector<int> saIs(const vector<int>& s, int upper)
+{
+    int n = (int)s.size();
+    if(n == 0)
+        return {};
+    if(n == 1)
+        return {0};
+    if(n == 2)
+        return s[0] < s[1] ? vector<int>{0, 1} : vector<int>{1, 0};
+
+    vector<int> sa(n);
+    vector<char> isS(n, 0); // suffix i < suffix i+1; the last suffix is L
+    for(int i = n - 2; i >= 0; i--)
+        isS[i] = s[i] == s[i+1] ? isS[i+1] : s[i] < s[i+1];
+
+    // Bucket boundaries: within a character, L suffixes come before S suffixes.
+    // startL[c] = first slot of bucket c, startS[c] = first S slot of bucket c.
+    vector<int> startL(upper + 2, 0), startS(upper + 1, 0);
+    for(int i = 0; i < n; i++)
+    {
+        startL[s[i] + 1]++;
+        if(!isS[i])
+            startS[s[i]]++;
+    }
+    for(int c = 1; c <= upper + 1; c++)
+        startL[c] += startL[c-1];
+    for(int c = 0; c <= upper; c++)
+        startS[c] += startL[c];
+
+    auto isLMS = [&](int i) { return i > 0 && isS[i] && !isS[i-1]; };
+    auto induce = [&](const vector<int>& lms) {
+        fill(sa.begin(), sa.end(), -1);
+        vector<int> buf(startS.begin(), startS.end());
+        for(int d : lms)
+            sa[buf[s[d]]++] = d;
+        // L types left to right, starting with the last suffix (always L)
+        buf.assign(startL.begin(), startL.end() - 1);
+        sa[buf[s[n-1]]++] = n - 1;
+        for(int i = 0; i < n; i++)
+        {
+            int v = sa[i] - 1;
+            if(v >= 0 && !isS[v])
+                sa[buf[s[v]]++] = v;
+        }
+        // S types right to left, filling each bucket from its end
+        buf.assign(startL.begin() + 1, startL.end());
+        for(int i = n - 1; i >= 0; i--)
+        {
+            int v = sa[i] - 1;
+            if(v >= 0 && isS[v])
+                sa[--buf[s[v]]] = v;
+        }
+    };
+
+    vector<int> lms, lmsId(n, -1);
+    for(int i = 1; i < n; i++)
+        if(isLMS(i))
+        {
+            lmsId[i] = (int)lms.size();
+            lms.push_back(i);
+        }
+    int m = (int)lms.size();
+    induce(lms);
+    if(m == 0)
+        return sa;
+
+    // Name the LMS substrings in their induced order, equal substrings share a name
+    vector<int> sorted;
+    sorted.reserve(m);
+    for(int v : sa)
+        if(lmsId[v] >= 0)
+            sorted.push_back(v);
+    vector<int> reduced(m);
+    int name = 0;
+    reduced[lmsId[sorted[0]]] = 0;
+    for(int k = 1; k < m; k++)
+    {
+        int l = sorted[k-1], r = sorted[k];
+        int endL = lmsId[l] + 1 < m ? lms[lmsId[l] + 1] : n;
+        int endR = lmsId[r] + 1 < m ? lms[lmsId[r] + 1] : n;
+        bool same = endL - l == endR - r;
+        if(same)
+        {
+            while(l < endL && s[l] == s[r])
+                l++, r++;
+            same = l < n && r < n && s[l] == s[r] && l == endL;
+        }
+        if(!same)
+            name++;
+        reduced[lmsId[sorted[k]]] = name;
+    }
+    vector<int> order = saIs(reduced, name);
+    for(int k = 0; k < m; k++)
+        sorted[k] = lms[order[k]];
+    induce(sorted);
+    return sa;
+}
+
+class SuffixArray
+{
+    public:
+        vector<int> sa, rank, lcp; // lcp[i] = LCP(sa[i], sa[i+1])
+
+        SuffixArray(const string& str) : SuffixArray(bytes(str), 256) {}
+
+        // Symbols in [0, upper]; lets callers add separators below every byte
+        SuffixArray(const vector<int>& s, int upper) : s(s), n((int)s.size())
+        {
+            sa = saIs(s, upper);
+            rank.assign(n, 0);
+            for(int i = 0; i < n; i++)
+                rank[sa[i]] = i;
+            // Kasai
+            lcp.assign(max(n - 1, 0), 0);
+            for(int i = 0, h = 0; i < n; i++)
+            {
+                if(h > 0)
+                    h--;
+                if(rank[i] == n - 1)
+                {
+                    h = 0;
+                    continue;
+                }
+                int j = sa[rank[i] + 1];
+                while(i + h < n && j + h < n && s[i + h] == s[j + h])
+                    h++;
+                lcp[rank[i]] = h;
+            }
+            rmq = MinRMQ(lcp);
+        }
+
+        int size() const { return n; }
+
+        // Longest common prefix of the suffixes starting at i and j
+        int lcpOf(int i, int j) const
+        {
+            if(i == j)
+                return n - i;
+            int a = rank[i], b = rank[j];
+            if(a > b)
+                swap(a, b);
+            return rmq.query(a, b - 1);
+        }
+
+        // z[i] = lcpOf(0, i)
+        vector<int> zFunction() const
+        {
+            vector<int> z(n);
+            for(int i = 0; i < n; i++)
+                z[i] = lcpOf(0, i);
+            return z;
+        }
+
+        // Same result as prefix_function / prefix_function_optimised, derived from z
+        vector<int> prefixFunction() const
+        {
+            vector<int> pi(n, 0), z = zFunction();
+            for(int i = 1; i < n; i++)
+                if(z[i])
+                    pi[i + z[i] - 1] = max(pi[i + z[i] - 1], z[i]);
+            for(int i = n - 2; i >= 1; i--)
+                pi[i] = max(pi[i], pi[i+1] - 1);
+            return pi;
+        }
+
+        // Number of occurrences of p, two binary searches over sa. The empty
+        // pattern occurs at all n + 1 positions, which sa alone cannot represent.
+        int count(const string& p) const
+        {
+            if(p.empty())
+                return n + 1;
+            vector<int> q = bytes(p);
+            auto cmp = [&](int suffix, bool upper) {
+                // <0 if the suffix sorts before p, >0 after; upper treats p as a prefix bound
+                for(size_t k = 0; k < q.size(); k++)
+                {
+                    if(suffix + (int)k >= n)
+                        return -1;
+                    if(s[suffix + k] != q[k])
+                        return s[suffix + k] < q[k] ? -1 : 1;
+                }
+                return upper ? -1 : 1;
+            };
+            auto lo = partition_point(sa.begin(), sa.end(), [&](int v) { return cmp(v, false) < 0; });
+            auto hi = partition_point(sa.begin(), sa.end(), [&](int v) { return cmp(v, true) < 0; });
+            return (int)(hi - lo);
+        }
+
+        // (start, length) of a longest substring occurring at least twice
+        pair<int,int> longestRepeated() const
+        {
+            int best = 0, at = 0;
+            for(int i = 0; i + 1 < n; i++)
+                if(lcp[i] > best)
+                {
+                    best = lcp[i];
+                    at = sa[i];
+                }
+            return {at, best};
+        }
+
+        long long distinctSubstrings() const
+        {
+            long long total = (long long)n * (n + 1) / 2;
+            for(int h : lcp)
+                total -= h;
+            return total;
+        }
+
+        static vector<int> bytes(const string& str)
+        {
+            vector<int> v(str.size());
+            for(size_t i = 0; i < str.size(); i++)
+                v[i] = (unsigned char)str[i] + 1; // 0 is left free for separators
+            return v;
+        }
+
+    private:
+        vector<int> s;
+        int n;
+        MinRMQ rmq;
+};
+
+// Start of the lexicographically smallest rotation (smallest index among equal ones)
+int minimumRotation(const string& str)
+{
+    int n = (int)str.size();
+    if(n == 0)
+        return 0;
+    SuffixArray idx(str + str);
+    int best = -1;
+    for(int v : idx.sa)
+        if(v < n)
+        {
+            if(best == -1)
+                best = v;
+            else if(idx.lcpOf(best, v) >= n)
+                best = min(best, v);
+            else
+                break;
+        }
+    return best;
+}
+
+// findMinimumShiftLCP: the shift of str2 whose rotation shares the longest prefix
+// with str1, as (shift, length). One index over str1 # str2 str2.
+pair<int,int> bestShift(const string& str1, const string& str2)
+{
+    vector<int> t = SuffixArray::bytes(str1);
+    vector<int> b = SuffixArray::bytes(str2 + str2);
+    int n1 = (int)t.size(), m = (int)str2.size();
+    t.push_back(0);
+    t.insert(t.end(), b.begin(), b.end());
+    SuffixArray idx(t, 256);
+    pair<int,int> best = {0, 0};
+    for(int p = 0; p < m; p++)
+    {
+        int len = min(idx.lcpOf(0, n1 + 1 + p), m);
+        if(len > best.second)
+            best = {p, len};
+    }
+    return best;
+}
+
+int main()
+{
+    // findMinimumShiftLCP_wellsFargo.cpp
+    string str1 = "geeksforgeeks", str2 = "forgeeksgeeks";
+    pair<int,int> shift = bestShift(str1, str2);
+    cout << "Shift = " << shift.first << endl;
+    cout << "Prefix = " << str1.substr(0, shift.second) << endl;
+
+    string s = "banana";
+    SuffixArray idx(s);
+    pair<int,int> rep = idx.longestRepeated();
+    cout << "\n" << s << ": suffix array";
+    for(int v : idx.sa)
+        cout << " " << v;
+    cout << "\nlongest repeated substring \"" << s.substr(rep.first, rep.second) << "\", "
+         << idx.distinctSubstrings() << " distinct substrings, \"ana\" occurs "
+         << idx.count("ana") << " times, lcp(1, 3) = " << idx.lcpOf(1, 3) << endl;
+    cout << "prefix function of aabaaab:";
+    for(int v : SuffixArray("aabaaab").prefixFunction())
+        cout << " " << v;
+    string r = "bbaaccaadd";
+    cout << "\nminimum rotation of " << r << ": " << r.substr(minimumRotation(r)) + r.substr(0, minimumRotation(r)) << endl;
+
+    // Construction time on 10^7 random bytes
+    int n = 10000000;
+    mt19937 rng(6);
+    string big(n, ' ');
+    for(auto& c : big)
+        c = 'a' + rng() % 4;
+    auto start = chrono::steady_clock::now();
+    SuffixArray bigIdx(big);
+    double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    pair<int,int> longest = bigIdx.longestRepeated();
+    cout << "\n" << n << " characters: SA + LCP + RMQ in " << secs << " s, longest repeat "
+         << longest.second << " characters" << endl;
+    return 0;
+}
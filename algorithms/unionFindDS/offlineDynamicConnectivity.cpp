@@ -0,0 +1,251 @@
+// Offline dynamic connectivity using a DSU with rollback and
+// divide and conquer over time (segment tree on the query timeline).
+//
+// Input:
+//   n q
+//   q lines of the form  "+ u v"  (add edge),  "- u v"  (remove edge),
+//                        "? u v"  (are u and v connected?)
+// Vertices are 0-indexed. Prints YES / NO for every "?" line in order.
+//
+// Every edge is alive on a time interval [l, r). The interval is inserted into
+// O(log q) segment tree nodes, and a DFS over the segment tree applies the
+// unions of a node on entry and undoes them on exit. The DSU uses union by
+// size and no path compression so every union is a constant-size change that
+// can be reverted. Total O(q log q log n).
+//
+// Usage: ./offlineDynamicConnectivity < input     ./offlineDynamicConnectivity --check
+#include <bits/stdc++.h>
+using namespace std;
+
+class RollbackDSU
+{
+    public:
+        vector<int> parent, size;
+        vector<pair<int,int>> history; // (attached root, new parent) per union
+        int components;
+
+        RollbackDSU(int n) : parent(n), size(n, 1), components(n)
+        {
+            iota(parent.begin(), parent.end(), 0);
+        }
+
+        int find_set(int v) const
+        {
+            while(v != parent[v])
+                v = parent[v];
+            return v;
+        }
+
+        bool union_sets(int a, int b)
+        {
+            a = find_set(a);
+            b = find_set(b);
+            if(a == b)
+                return false;
+            if(size[a] < size[b])
+                swap(a, b);
+            parent[b] = a;
+            size[a] += size[b];
+            components--;
+            history.push_back({b, a});
+            return true;
+        }
+
+        int snapshot() const
+        {
+            return (int)history.size();
+        }
+
+        // Undo every union performed after the given snapshot
+        void rollback(int snap)
+        {
+            while((int)history.size() > snap)
+            {
+                int b = history.back().first, a = history.back().second;
+                history.pop_back();
+                size[a] -= size[b];
+                parent[b] = b;
+                components++;
+            }
+        }
+};
+
+class OfflineConnectivity
+{
+    public:
+        int n, T;
+        vector<vector<pair<int,int>>> tree; // edges alive over the whole node range
+        vector<pair<int,int>> queries;      // per time step, (-1,-1) if not a query
+        vector<char> answer;
+
+        OfflineConnectivity(int n, int T) : n(n), T(T), tree(4*max(T,1)),
+                                            queries(T, {-1,-1}), answer(T, 0) {}
+
+        void addEdge(int l, int r, pair<int,int> e)
+        {
+            if(l < r)
+                insert(1, 0, T, l, r, e);
+        }
+
+        void addQuery(int t, int u, int v)
+        {
+            queries[t] = {u, v};
+        }
+
+        void solve()
+        {
+            RollbackDSU dsu(n);
+            dfs(1, 0, T, dsu);
+        }
+
+    private:
+        void insert(int idx, int lo, int hi, int l, int r, const pair<int,int>& e)
+        {
+            if(r <= lo || hi <= l)
+                return;
+            if(l <= lo && hi <= r)
+            {
+                tree[idx].push_back(e);
+                return;
+            }
+            int mid = (lo + hi)/2;
+            insert(2*idx, lo, mid, l, r, e);
+            insert(2*idx+1, mid, hi, l, r, e);
+        }
+
+        void dfs(int idx, int lo, int hi, RollbackDSU& dsu)
+        {
+            if(lo >= hi) // only for T = 0: there is no time step to visit
+                return;
+            int snap = dsu.snapshot();
+            for(auto& e : tree[idx])
+                dsu.union_sets(e.first, e.second);
+            if(hi - lo == 1)
+            {
+                if(queries[lo].first != -1)
+                    answer[lo] = dsu.find_set(queries[lo].first) == dsu.find_set(queries[lo].second);
+            }
+            else
+            {
+                int mid = (lo + hi)/2;
+                dfs(2*idx, lo, mid, dsu);
+                dfs(2*idx+1, mid, hi, dsu);
+            }
+            dsu.rollback(snap);
+        }
+};
+
+struct Op
+{
+    char type; // '+', '-' or '?'
+    int u, v;
+};
+
+// Answers of the "?" operations, in order. Removing an edge that is not present
+// is ignored; edges still present at the end stay alive until time q.
+vector<char> connectivity(int n, const vector<Op>& ops)
+{
+    int q = (int)ops.size();
+    OfflineConnectivity solver(n, q);
+    // Start times of currently alive copies of every edge (multi-edges allowed)
+    unordered_map<long long, vector<int>> open;
+    open.reserve(2*q);
+    auto key = [](int u, int v) { if(u > v) swap(u, v); return ((long long)u << 32) | (unsigned)v; };
+
+    for(int t = 0; t < q; t++)
+    {
+        int u = ops[t].u, v = ops[t].v;
+        if(ops[t].type == '+')
+            open[key(u, v)].push_back(t);
+        else if(ops[t].type == '-')
+        {
+            auto it = open.find(key(u, v));
+            if(it == open.end() || it->second.empty())
+                continue;
+            solver.addEdge(it->second.back(), t, {u, v});
+            it->second.pop_back();
+        }
+        else
+            solver.addQuery(t, u, v);
+    }
+    for(auto& kv : open)
+        for(int start : kv.second)
+            solver.addEdge(start, q, {(int)(kv.first >> 32), (int)(kv.first & 0xffffffffLL)});
+
+    solver.solve();
+    vector<char> res;
+    for(int t = 0; t < q; t++)
+        if(solver.queries[t].first != -1)
+            res.push_back(solver.answer[t]);
+    return res;
+}
+
+// Rebuilds the components from the live edge multiset at every query
+static vector<char> naiveConnectivity(int n, const vector<Op>& ops)
+{
+    multiset<pair<int,int>> alive;
+    vector<char> res;
+    for(const Op& op : ops)
+    {
+        pair<int,int> e = minmax(op.u, op.v);
+        if(op.type == '+')
+            alive.insert(e);
+        else if(op.type == '-')
+        {
+            auto it = alive.find(e);
+            if(it != alive.end())
+                alive.erase(it);
+        }
+        else
+        {
+            RollbackDSU dsu(n);
+            for(auto& a : alive)
+                dsu.union_sets(a.first, a.second);
+            res.push_back(dsu.find_set(op.u) == dsu.find_set(op.v));
+        }
+    }
+    return res;
+}
+
+// Random operation sequences against the naive version, including q = 0
+static bool selfCheck()
+{
+    mt19937 rng(26);
+    bool ok = connectivity(3, {}).empty();
+    for(int it = 0; it < 500 && ok; it++)
+    {
+        int n = 1 + rng() % 8, q = it % 50 == 0 ? 0 : rng() % 60;
+        vector<Op> ops(q);
+        for(auto& op : ops)
+            op = {"+-?"[rng() % 3], (int)(rng() % n), (int)(rng() % n)};
+        ok &= connectivity(n, ops) == naiveConnectivity(n, ops);
+    }
+    puts(ok ? "self-check ok" : "self-check FAILED");
+    return ok;
+}
+
+int main(int argc, char** argv)
+{
+    if(argc > 1 && !strcmp(argv[1], "--check"))
+        return selfCheck() ? 0 : 1;
+    int n, q;
+    if(scanf("%d %d", &n, &q) != 2 || n <= 0 || q < 0)
+        return 0;
+
+    vector<Op> ops(q);
+    for(int t = 0; t < q; t++)
+    {
+        char op[2];
+        Op& o = ops[t];
+        if(scanf("%1s %d %d", op, &o.u, &o.v) != 3 || !strchr("+-?", op[0])
+           || o.u < 0 || o.u >= n || o.v < 0 || o.v >= n)
+        {
+            fprintf(stderr, "bad operation %d\n", t + 1);
+            return 1;
+        }
+        o.type = op[0];
+    }
+    for(char yes : connectivity(n, ops))
+        puts(yes ? "YES" : "NO");
+    return 0;
+}
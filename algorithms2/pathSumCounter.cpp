@@ -0,0 +1,204 @@
+// Counting downward paths with a given sum (LeetCode 437) in one iterative DFS.
+//
+// pathSum.cpp keeps prefix sums in a map<int,int>: one tree node allocation per
+// insert, int overflow on long paths, and recursion in the usual formulation.
+// PathSumCounter instead uses
+//
+//  - PrefixCounts, an open-addressing (linear probing) table from 64-bit prefix
+//    sum to count, sized once for the whole walk: there are at most n+1 distinct
+//    prefix sums, so with capacity >= 2(n+1) it never grows or rehashes
+//  - an undo log: entering a node increments one slot and remembers its index,
+//    leaving the node decrements that slot again. Keys whose count drops to 0
+//    stay in the table, so there is no deletion and no tombstones.
+//  - an explicit stack, so depth is not limited by the call stack
+//
+// A path ending at v with sum t exists for every ancestor prefix equal to
+// prefix(v) - t, so several targets are answered in the same walk by doing one
+// lookup per target at each node.
+#include <bits/stdc++.h>
+using namespace std;
+
+struct TreeNode {
+    int val;
+    TreeNode *left;
+    TreeNode *right;
+    TreeNode() : val(0), left(nullptr), right(nullptr) {}
+    TreeNode(int x) : val(x), left(nullptr), right(nullptr) {}
+    TreeNode(int x, TreeNode *left, TreeNode *right) : val(x), left(left), right(right) {}
+};
+
+class PrefixCounts {
+public:
+    explicit PrefixCounts(size_t maxKeys) {
+        size_t cap = 16;
+        shift = 60;
+        while (cap < 2 * maxKeys) {
+            cap <<= 1;
+            shift--;
+        }
+        mask = cap - 1;
+        slots.assign(cap, Slot());
+    }
+
+    // Count for key, 0 when absent
+    int get(long long key) const {
+        for (size_t i = home(key); ; i = (i + 1) & mask) {
+            if (!slots[i].used)
+                return 0;
+            if (slots[i].key == key)
+                return slots[i].count;
+        }
+    }
+
+    // Increments key and returns its slot so the caller can undo it later
+    size_t increment(long long key) {
+        size_t i = home(key);
+        while (slots[i].used && slots[i].key != key)
+            i = (i + 1) & mask;
+        slots[i].used = true;
+        slots[i].key = key;
+        slots[i].count++;
+        return i;
+    }
+
+    void decrementSlot(size_t i) { slots[i].count--; }
+
+private:
+    struct Slot {
+        long long key = 0;
+        int count = 0;
+        bool used = false;
+    };
+    vector<Slot> slots;
+    size_t mask;
+    int shift; // multiplicative hashing keeps the top log2(capacity) bits
+
+    size_t home(long long key) const {
+        return (size_t)(((unsigned long long)key * 0x9e3779b97f4a7c15ULL) >> shift);
+    }
+};
+
+class PathSumCounter {
+public:
+    explicit PathSumCounter(TreeNode* root) : root(root) {
+        // Size the table from the node count so the walk never reallocates
+        vector<TreeNode*> st;
+        if (root)
+            st.push_back(root);
+        while (!st.empty()) {
+            TreeNode* u = st.back();
+            st.pop_back();
+            n++;
+            if (u->left)
+                st.push_back(u->left);
+            if (u->right)
+                st.push_back(u->right);
+        }
+    }
+
+    long long count(long long target) const { return count(vector<long long>{target})[0]; }
+
+    // Number of downward paths summing to each target, all in one traversal
+    vector<long long> count(const vector<long long>& targets) const {
+        vector<long long> res(targets.size(), 0);
+        if (!root)
+            return res;
+        PrefixCounts seen(n + 1);
+        seen.increment(0); // the empty prefix above the root
+        // Each frame is a node whose prefix is in the table; `undo` is its slot
+        struct Frame {
+            TreeNode* node;
+            long long prefix;
+            size_t undo;
+            int state; // 0: left child next, 1: right child next, 2: done
+        };
+        vector<Frame> st;
+        auto enter = [&](TreeNode* u, long long parentPrefix) {
+            long long p = parentPrefix + u->val;
+            for (size_t i = 0; i < targets.size(); i++)
+                res[i] += seen.get(p - targets[i]);
+            st.push_back({u, p, seen.increment(p), 0});
+        };
+        enter(root, 0);
+        while (!st.empty()) {
+            Frame& f = st.back();
+            TreeNode* child = f.state == 0 ? f.node->left : f.state == 1 ? f.node->right : nullptr;
+            if (f.state++ < 2) {
+                if (child)
+                    enter(child, f.prefix);
+                continue;
+            }
+            seen.decrementSlot(f.undo);
+            st.pop_back();
+        }
+        return res;
+    }
+
+private:
+    TreeNode* root;
+    size_t n = 0;
+};
+
+// LeetCode 437 signature
+int pathSum(TreeNode* root, int targetSum) {
+    return (int)PathSumCounter(root).count(targetSum);
+}
+
+// map-based recursive version in the style of pathSum.cpp, for comparison
+static long long mapCount(TreeNode* u, long long prefix, long long target, map<long long, int>& d) {
+    if (!u)
+        return 0;
+    prefix += u->val;
+    long long res = d.count(prefix - target) ? d[prefix - target] : 0;
+    d[prefix]++;
+    res += mapCount(u->left, prefix, target, d) + mapCount(u->right, prefix, target, d);
+    d[prefix]--;
+    return res;
+}
+
+int main() {
+    // LeetCode 437 example: [10,5,-3,3,2,null,11,3,-2,null,1], targetSum = 8 -> 3
+    TreeNode* ex = new TreeNode(10,
+        new TreeNode(5, new TreeNode(3, new TreeNode(3), new TreeNode(-2)),
+                        new TreeNode(2, nullptr, new TreeNode(1))),
+        new TreeNode(-3, nullptr, new TreeNode(11)));
+    cout << "pathSum(example, 8) = " << pathSum(ex, 8) << endl;
+
+    // A random tree of 10^6 nodes and a chain of 10^6 large values (sums need 64 bits)
+    mt19937 rng(9);
+    int n = 1000000;
+    vector<TreeNode*> nodes = {new TreeNode(rng() % 21 - 10)};
+    for (int i = 1; i < n; i++) {
+        TreeNode* u = nodes[rng() % nodes.size()];
+        while (u->left && u->right)
+            u = (rng() & 1) ? u->left : u->right;
+        TreeNode* c = new TreeNode(rng() % 21 - 10);
+        (u->left ? u->right : u->left) = c;
+        nodes.push_back(c);
+    }
+    vector<long long> targets;
+    for (int t = -20; t <= 20; t += 4)
+        targets.push_back(t);
+
+    PathSumCounter counter(nodes[0]);
+    auto start = chrono::steady_clock::now();
+    vector<long long> fast = counter.count(targets);
+    double tFast = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    start = chrono::steady_clock::now();
+    bool ok = true;
+    for (size_t i = 0; i < targets.size(); i++) {
+        map<long long, int> d = {{0, 1}};
+        ok &= mapCount(nodes[0], 0, targets[i], d) == fast[i];
+    }
+    double tMap = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << targets.size() << " targets on " << n << " nodes: flat table " << tFast
+         << " s, map " << tMap << " s, " << (ok ? "results match" : "MISMATCH") << endl;
+
+    TreeNode* chain = nullptr;
+    for (int i = 0; i < n; i++)
+        chain = new TreeNode(INT_MAX, chain, nullptr);
+    long long whole = (long long)INT_MAX * n;
+    cout << "paths of sum " << whole << " in a chain of " << n << " x INT_MAX: "
+         << PathSumCounter(chain).count(whole) << endl;
+    return 0;
+}
@@ -0,0 +1,243 @@
+// Merkle-style subtree hashes for repeated tree comparisons.
+//
+// isSameTree.cpp and isSymmetricTree.cpp walk both trees on every call. Here every
+// node stores two 64-bit hashes, computed bottom-up in one pass:
+//
+//    hash(v)   = H(v->val, hash(v->left),   hash(v->right))
+//    mirror(v) = H(v->val, mirror(v->right), mirror(v->left))
+//
+// H is order sensitive and seeded at random, so two subtrees are equal exactly
+// when their hashes are (up to a ~2^-64 collision chance per pair), and b is the
+// mirror image of a when hash(a) == mirror(b). A node's hashes depend only on its
+// subtree, so after a change only the path to the root is recomputed, and the
+// walk stops as soon as a node's hashes come out unchanged. A count per hash
+// value makes "does this subtree occur twice" an O(1) lookup as well.
+#include <bits/stdc++.h>
+using namespace std;
+
+struct TreeNode {
+    int val;
+    TreeNode *left;
+    TreeNode *right;
+    TreeNode() : val(0), left(nullptr), right(nullptr) {}
+    TreeNode(int x) : val(x), left(nullptr), right(nullptr) {}
+    TreeNode(int x, TreeNode *left, TreeNode *right) : val(x), left(left), right(right) {}
+};
+
+class SubtreeHashIndex {
+public:
+    explicit SubtreeHashIndex(TreeNode* root, uint64_t seed = random_device{}())
+        : root(root), seed(mix(seed)), nullHash(mix(this->seed ^ 0x5bd1e995)) {
+        addSubtree(root, nullptr);
+    }
+
+    TreeNode* getRoot() const { return root; }
+    uint64_t hash(TreeNode* node) const { return node ? info.at(node).hash : nullHash; }
+    uint64_t mirror(TreeNode* node) const { return node ? info.at(node).mirror : nullHash; }
+
+    // isSameTree.cpp for two indexed subtrees
+    bool sameTree(TreeNode* a, TreeNode* b) const { return hash(a) == hash(b); }
+    // b is a with every left and right swapped
+    bool mirrorTrees(TreeNode* a, TreeNode* b) const { return hash(a) == mirror(b); }
+    // isSymmetricTree.cpp: the subtree equals its own mirror image
+    bool isSymmetric(TreeNode* node) const { return hash(node) == mirror(node); }
+    bool isSymmetric() const { return isSymmetric(root); }
+
+    // Another subtree with the same shape and values exists. False for nullptr and
+    // for nodes outside the indexed tree.
+    bool hasDuplicate(TreeNode* node) const {
+        auto in = info.find(node);
+        if (in == info.end())
+            return false;
+        auto it = count.find(in->second.hash);
+        return it != count.end() && it->second > 1;
+    }
+
+    // One root for every subtree that occurs more than once (LeetCode 652)
+    vector<TreeNode*> duplicateSubtrees() const {
+        vector<TreeNode*> res;
+        unordered_set<uint64_t> reported;
+        for (auto& p : info)
+            if (count.at(p.second.hash) > 1 && reported.insert(p.second.hash).second)
+                res.push_back(p.first);
+        return res;
+    }
+
+    void setValue(TreeNode* node, int val) {
+        node->val = val;
+        refresh(node);
+    }
+
+    // Hangs `subtree` under parent (left or right side; parent == nullptr replaces
+    // the root). The old subtree is detached and returned, it is not freed.
+    TreeNode* replaceChild(TreeNode* parent, bool leftSide, TreeNode* subtree) {
+        TreeNode*& slot = !parent ? root : leftSide ? parent->left : parent->right;
+        TreeNode* old = slot;
+        removeSubtree(old);
+        slot = subtree;
+        addSubtree(subtree, parent);
+        if (parent)
+            refresh(parent);
+        return old;
+    }
+
+private:
+    struct Info {
+        uint64_t hash, mirror;
+        TreeNode* parent;
+    };
+
+    TreeNode* root;
+    uint64_t seed, nullHash;
+    unordered_map<TreeNode*, Info> info;
+    unordered_map<uint64_t, int> count;
+
+    // splitmix64 finalizer
+    static uint64_t mix(uint64_t x) {
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    uint64_t combine(int val, uint64_t first, uint64_t second) const {
+        return mix(mix(mix(seed ^ (uint32_t)val) ^ first) + second);
+    }
+
+    // Recomputes node's hashes from its children, true if they changed
+    bool recompute(TreeNode* node, Info& in) {
+        uint64_t h = combine(node->val, hash(node->left), hash(node->right));
+        uint64_t m = combine(node->val, mirror(node->right), mirror(node->left));
+        if (h == in.hash && m == in.mirror)
+            return false;
+        if (--count[in.hash] == 0)
+            count.erase(in.hash);
+        in.hash = h;
+        in.mirror = m;
+        count[h]++;
+        return true;
+    }
+
+    void refresh(TreeNode* node) {
+        while (node) {
+            Info& in = info.at(node);
+            if (!recompute(node, in))
+                break;
+            node = in.parent;
+        }
+    }
+
+    // Preorder list of a subtree without recursion; reversed it puts children first
+    static vector<TreeNode*> preorder(TreeNode* node) {
+        vector<TreeNode*> order, st;
+        if (node)
+            st.push_back(node);
+        while (!st.empty()) {
+            TreeNode* u = st.back();
+            st.pop_back();
+            order.push_back(u);
+            if (u->right)
+                st.push_back(u->right);
+            if (u->left)
+                st.push_back(u->left);
+        }
+        return order;
+    }
+
+    void addSubtree(TreeNode* node, TreeNode* parent) {
+        vector<TreeNode*> order = preorder(node);
+        info.reserve(info.size() + order.size());
+        if (node)
+            info[node].parent = parent;
+        for (TreeNode* u : order) {
+            if (u->left)
+                info[u->left].parent = u;
+            if (u->right)
+                info[u->right].parent = u;
+        }
+        for (size_t i = order.size(); i-- > 0; ) {
+            TreeNode* u = order[i];
+            Info& in = info[u];
+            in.hash = combine(u->val, hash(u->left), hash(u->right));
+            in.mirror = combine(u->val, mirror(u->right), mirror(u->left));
+            count[in.hash]++;
+        }
+    }
+
+    void removeSubtree(TreeNode* node) {
+        for (TreeNode* u : preorder(node)) {
+            uint64_t h = info.at(u).hash;
+            if (--count[h] == 0)
+                count.erase(h);
+            info.erase(u);
+        }
+    }
+};
+
+// Full comparison used to check the hashes, same as isSameTree.cpp but iterative
+static bool walkSame(TreeNode* p, TreeNode* q) {
+    vector<pair<TreeNode*, TreeNode*>> st = {{p, q}};
+    while (!st.empty()) {
+        auto [a, b] = st.back();
+        st.pop_back();
+        if (!a || !b) {
+            if (a != b)
+                return false;
+            continue;
+        }
+        if (a->val != b->val)
+            return false;
+        st.push_back({a->left, b->left});
+        st.push_back({a->right, b->right});
+    }
+    return true;
+}
+
+int main() {
+    // LeetCode 652 example: [1,2,3,4,null,2,4,null,null,4]
+    TreeNode* ex = new TreeNode(1,
+        new TreeNode(2, new TreeNode(4), nullptr),
+        new TreeNode(3, new TreeNode(2, new TreeNode(4), nullptr), new TreeNode(4)));
+    SubtreeHashIndex idx(ex);
+    cout << "duplicate subtrees:";
+    for (TreeNode* d : idx.duplicateSubtrees())
+        cout << " [" << d->val << (d->left ? ",..." : "") << "]";
+    cout << endl;
+
+    // isSymmetricTree.cpp example [1,2,2,3,4,4,3], then break and repair the symmetry
+    TreeNode* sym = new TreeNode(1,
+        new TreeNode(2, new TreeNode(3), new TreeNode(4)),
+        new TreeNode(2, new TreeNode(4), new TreeNode(3)));
+    SubtreeHashIndex s(sym);
+    cout << "symmetric: " << s.isSymmetric();
+    s.setValue(sym->right->left, 5);
+    cout << ", after setting a leaf to 5: " << s.isSymmetric();
+    s.setValue(sym->left->right, 5);
+    cout << ", after mirroring the change: " << s.isSymmetric() << endl;
+    cout << "left and right subtrees are mirrors: " << s.mirrorTrees(sym->left, sym->right) << endl;
+
+    // Random trees with few distinct values: compare every hash answer with a walk
+    mt19937 rng(5);
+    int n = 200000, wrong = 0, queries = 2000;
+    vector<TreeNode*> nodes = {new TreeNode(0)};
+    for (int i = 1; i < n; i++) {
+        TreeNode* u = nodes[rng() % nodes.size()];
+        while (u->left && u->right)
+            u = (rng() & 1) ? u->left : u->right;
+        TreeNode* c = new TreeNode(rng() % 2);
+        ((u->left || (!u->right && (rng() & 1))) ? u->right : u->left) = c;
+        nodes.push_back(c);
+    }
+    SubtreeHashIndex big(nodes[0]);
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < queries; i++) {
+        TreeNode *a = nodes[rng() % n], *b = nodes[rng() % n];
+        if (i % 4 == 0)
+            big.setValue(a, rng() % 2);
+        wrong += big.sameTree(a, b) != walkSame(a, b);
+    }
+    double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << n << " nodes, " << queries << " mixed updates/queries in " << secs
+         << " s, mismatches: " << wrong << endl;
+    return 0;
+}
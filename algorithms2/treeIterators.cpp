@@ -0,0 +1,300 @@
+// Non-recursive binary tree traversals.
+//
+// Tree-Traversal.cpp, inorder() in deleteNode.cpp and the solutions in
+// isSameTree.cpp, isSymmetricTree.cpp and pathSum.cpp recurse once per level, so a
+// degenerate tree of depth 10^6 overflows the call stack. Everything here keeps
+// its state on the heap (or, for Morris, in the tree itself):
+//
+//  - PreorderIterator   explicit stack; can also emit the missing children as
+//                       nullptr and visit right before left ("mirrored"), which
+//                       is what same-tree / symmetric-tree comparisons need
+//  - InorderIterator    explicit stack
+//  - PostorderIterator  explicit stack, the stack always holds the ancestors of
+//                       the node being returned
+//  - LevelOrderIterator queue
+//  - MorrisInorder / MorrisPreorder   O(1) extra space: temporarily threads the
+//                       right pointer of each in-order predecessor back to its
+//                       successor. The tree is restored once the walk finishes,
+//                       the destructor finishes an abandoned walk for that reason.
+//
+// Every iterator is used as:  TreeNode* node; while(it.next(node)) { ... }
+#include <bits/stdc++.h>
+using namespace std;
+
+struct TreeNode {
+    int val;
+    TreeNode *left;
+    TreeNode *right;
+    TreeNode() : val(0), left(nullptr), right(nullptr) {}
+    TreeNode(int x) : val(x), left(nullptr), right(nullptr) {}
+    TreeNode(int x, TreeNode *left, TreeNode *right) : val(x), left(left), right(right) {}
+};
+
+class PreorderIterator {
+public:
+    PreorderIterator(TreeNode* root, bool withNulls = false, bool mirrored = false)
+        : withNulls(withNulls), mirrored(mirrored) {
+        if (root || withNulls)
+            st.push_back(root);
+    }
+
+    bool next(TreeNode*& node) {
+        if (st.empty())
+            return false;
+        node = st.back();
+        st.pop_back();
+        if (node) {
+            // Pushed in reverse so the first child is on top
+            TreeNode* first = mirrored ? node->right : node->left;
+            TreeNode* second = mirrored ? node->left : node->right;
+            if (second || withNulls)
+                st.push_back(second);
+            if (first || withNulls)
+                st.push_back(first);
+        }
+        return true;
+    }
+
+private:
+    vector<TreeNode*> st;
+    bool withNulls, mirrored;
+};
+
+class InorderIterator {
+public:
+    InorderIterator(TreeNode* root) { pushLeft(root); }
+
+    bool next(TreeNode*& node) {
+        if (st.empty())
+            return false;
+        node = st.back();
+        st.pop_back();
+        pushLeft(node->right);
+        return true;
+    }
+
+private:
+    vector<TreeNode*> st;
+
+    void pushLeft(TreeNode* node) {
+        for (; node; node = node->left)
+            st.push_back(node);
+    }
+};
+
+class PostorderIterator {
+public:
+    PostorderIterator(TreeNode* root) { descend(root); }
+
+    bool next(TreeNode*& node) {
+        unchanged = returned;
+        if (pending) {
+            descend(pending);
+            pending = nullptr;
+        }
+        if (st.empty())
+            return false;
+        node = st.back();
+        st.pop_back();
+        unchanged = min(unchanged, st.size());
+        // Coming up from the left child: the right subtree goes next. The descent
+        // is deferred so that ancestors() is exact until the following call.
+        if (!st.empty() && st.back()->left == node && st.back()->right)
+            pending = st.back()->right;
+        returned = st.size();
+        return true;
+    }
+
+    // Ancestors of the node returned last, root first
+    const vector<TreeNode*>& ancestors() const { return st; }
+    // How many of those (from the root) were already ancestors of the previous node
+    size_t unchangedAncestors() const { return unchanged; }
+
+private:
+    vector<TreeNode*> st;
+    TreeNode* pending = nullptr;
+    size_t unchanged = 0, returned = 0; // `returned` = ancestors of the previous node
+
+    // Push the path to the first node in postorder of this subtree
+    void descend(TreeNode* node) {
+        while (node) {
+            st.push_back(node);
+            node = node->left ? node->left : node->right;
+        }
+    }
+};
+
+class LevelOrderIterator {
+public:
+    LevelOrderIterator(TreeNode* root) {
+        if (root)
+            q.push_back(root);
+    }
+
+    bool next(TreeNode*& node) {
+        if (head == q.size())
+            return false;
+        node = q[head++];
+        if (node->left)
+            q.push_back(node->left);
+        if (node->right)
+            q.push_back(node->right);
+        // Drop the consumed prefix once it dominates the buffer
+        if (head > 4096 && head * 2 > q.size()) {
+            q.erase(q.begin(), q.begin() + head);
+            head = 0;
+        }
+        return true;
+    }
+
+private:
+    vector<TreeNode*> q;
+    size_t head = 0;
+};
+
+// Shared walk for the two Morris traversals, they only differ in when a node is reported
+template<bool preorder>
+class MorrisIterator {
+public:
+    MorrisIterator(TreeNode* root) : cur(root) {}
+    ~MorrisIterator() {
+        TreeNode* node;
+        while (next(node))
+            ;
+    }
+    MorrisIterator(const MorrisIterator&) = delete;
+    MorrisIterator& operator=(const MorrisIterator&) = delete;
+
+    bool next(TreeNode*& node) {
+        while (cur) {
+            if (!cur->left) {
+                node = cur;
+                cur = cur->right;
+                return true;
+            }
+            TreeNode* pred = cur->left;
+            while (pred->right && pred->right != cur)
+                pred = pred->right;
+            if (!pred->right) {
+                // First visit: thread the predecessor back to cur and go left
+                pred->right = cur;
+                TreeNode* visit = cur;
+                cur = cur->left;
+                if (preorder) {
+                    node = visit;
+                    return true;
+                }
+            } else {
+                // Second visit: the left subtree is done, remove the thread
+                pred->right = nullptr;
+                TreeNode* visit = cur;
+                cur = cur->right;
+                if (!preorder) {
+                    node = visit;
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+private:
+    TreeNode* cur;
+};
+
+typedef MorrisIterator<false> MorrisInorder;
+typedef MorrisIterator<true> MorrisPreorder;
+
+// Walks two "with nulls" preorder iterators in lockstep
+static bool sameSequence(PreorderIterator& a, PreorderIterator& b) {
+    TreeNode *x, *y;
+    while (a.next(x)) {
+        if (!b.next(y))
+            return false;
+        if (!x || !y) {
+            if (x != y)
+                return false;
+        } else if (x->val != y->val)
+            return false;
+    }
+    return !b.next(y);
+}
+
+// isSameTree.cpp: equal shapes and values <=> equal preorder sequences with the nulls
+bool isSameTree(TreeNode* p, TreeNode* q) {
+    PreorderIterator a(p, true), b(q, true);
+    return sameSequence(a, b);
+}
+
+// isSymmetricTree.cpp: the left subtree read normally must match the right one read mirrored
+bool isSymmetric(TreeNode* root) {
+    if (!root)
+        return true;
+    PreorderIterator a(root->left, true), b(root->right, true, true);
+    return sameSequence(a, b);
+}
+
+// pathSum.cpp: root-to-leaf path with the given sum. prefix[i] is the sum of the
+// first i+1 ancestors; only the ancestors that changed since the previous node are
+// recomputed, so the whole walk is O(n) with 64-bit sums.
+bool hasPathSum(TreeNode* root, long long targetSum) {
+    PostorderIterator it(root);
+    vector<long long> prefix;
+    TreeNode* node;
+    while (it.next(node)) {
+        const vector<TreeNode*>& anc = it.ancestors();
+        prefix.resize(it.unchangedAncestors());
+        for (size_t i = prefix.size(); i < anc.size(); i++)
+            prefix.push_back((prefix.empty() ? 0 : prefix.back()) + anc[i]->val);
+        if (!node->left && !node->right &&
+            (prefix.empty() ? 0 : prefix.back()) + node->val == targetSum)
+            return true;
+    }
+    return false;
+}
+
+// Frees a tree of any depth without recursion. Postorder never looks at a node
+// again once it has been returned, so it can be deleted straight away.
+void deleteTree(TreeNode* root) {
+    PostorderIterator it(root);
+    TreeNode* node;
+    while (it.next(node))
+        delete node;
+}
+
+int main() {
+    const int depth = 1000000;
+    // A left chain, its copy, and a mirrored right chain, each 10^6 deep
+    TreeNode *left = nullptr, *copy = nullptr, *right = nullptr;
+    for (int i = depth; i >= 1; i--) {
+        left = new TreeNode(i, left, nullptr);
+        copy = new TreeNode(i, copy, nullptr);
+        right = new TreeNode(i, nullptr, right);
+    }
+
+    long long sum = 0;
+    TreeNode* node;
+    for (InorderIterator it(left); it.next(node); )
+        sum += node->val;
+    for (MorrisInorder it(left); it.next(node); )
+        sum -= node->val;
+    cout << "inorder sums agree: " << (sum == 0 ? "yes" : "no") << endl;
+
+    int count = 0;
+    for (MorrisPreorder it(right); it.next(node); )
+        count++;
+    for (LevelOrderIterator it(right); it.next(node); )
+        count--;
+    cout << "preorder/level order counts agree: " << (count == 0 ? "yes" : "no") << endl;
+
+    cout << "isSameTree(left, copy): " << isSameTree(left, copy) << endl;
+    cout << "isSameTree(left, right): " << isSameTree(left, right) << endl;
+    TreeNode* sym = new TreeNode(0, left, right);
+    cout << "isSymmetric(left <- 0 -> right): " << isSymmetric(sym) << endl;
+    long long total = (long long)depth * (depth + 1) / 2;
+    cout << "hasPathSum(copy, " << total << "): " << hasPathSum(copy, total) << endl;
+
+    deleteTree(sym);
+    deleteTree(copy);
+    return 0;
+}